@@ -0,0 +1,86 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Measures CBOR decoding throughput from a std::istream (binary_stream_source)
+// and from a byte vector (bytes_source).
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_document(std::size_t count)
+    {
+        json records(json_array_arg);
+        records.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json record;
+            record["id"] = i;
+            record["name"] = "record-" + std::to_string(i);
+            record["active"] = (i % 2) == 0;
+            record["lat"] = 43.65 + i*0.001;
+            record["lng"] = -79.38 - i*0.001;
+            json& values = record["values"] = json(json_array_arg);
+            for (std::size_t j = 0; j < 8; ++j)
+            {
+                values.push_back(static_cast<int64_t>(i*j) - 1000);
+            }
+            records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+    template <class F>
+    double measure(std::size_t size, int repetitions, F f)
+    {
+        double best = 0;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            f();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            double mbps = size / seconds / (1024.0 * 1024.0);
+            if (mbps > best)
+            {
+                best = mbps;
+            }
+        }
+        return best;
+    }
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(make_document(200000), data);
+    std::string s(data.begin(), data.end());
+
+    double stream_mbps = measure(data.size(), 5, [&]()
+    {
+        std::istringstream is(s);
+        basic_default_json_visitor<char> visitor;
+        cbor::cbor_stream_reader reader(is, visitor);
+        reader.read();
+    });
+    double bytes_mbps = measure(data.size(), 5, [&]()
+    {
+        basic_default_json_visitor<char> visitor;
+        cbor::cbor_bytes_reader reader(data, visitor);
+        reader.read();
+    });
+
+    std::cout << "CBOR document: " << data.size() << " bytes\n";
+    std::cout << "std::istream: " << stream_mbps << " MB/s\n";
+    std::cout << "bytes:        " << bytes_mbps << " MB/s\n";
+}
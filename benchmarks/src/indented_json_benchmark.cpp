@@ -0,0 +1,101 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Measures json_parser throughput on a pretty-printed (indented) document
+// and on the same document without whitespace. Build with benchmarks/CMakeLists.txt 
+// and compare indented_json_benchmark with indented_json_benchmark_scalar.
+
+#include <jsoncons/json.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_document(std::size_t count)
+    {
+        json records(json_array_arg);
+        records.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json record;
+            record["id"] = i;
+            record["name"] = "record-" + std::to_string(i);
+            record["active"] = (i % 2) == 0;
+            json& address = record["address"] = json();
+            address["street"] = "1 Main Street";
+            address["city"] = "Toronto";
+            json& location = address["location"] = json();
+            location["lat"] = 43.65 + i*0.001;
+            location["lng"] = -79.38 - i*0.001;
+            json& tags = record["tags"] = json(json_array_arg);
+            tags.push_back("alpha");
+            tags.push_back("beta");
+            json& history = record["history"] = json(json_array_arg);
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                json event;
+                event["seq"] = j;
+                json& detail = event["detail"] = json();
+                detail["code"] = 200 + j;
+                history.push_back(std::move(event));
+            }
+            records.push_back(std::move(record));
+        }
+        json doc;
+        doc["records"] = std::move(records);
+        return doc;
+    }
+
+    double measure(const std::string& input, int repetitions)
+    {
+        double best = 0;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            basic_default_json_visitor<char> visitor;
+            json_parser parser;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            parser.update(input.data(), input.size());
+            parser.finish_parse(visitor);
+            parser.check_done();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            double mbps = input.size() / seconds / (1024.0 * 1024.0);
+            if (mbps > best)
+            {
+                best = mbps;
+            }
+        }
+        return best;
+    }
+
+} // namespace
+
+int main()
+{
+    json doc = make_document(20000);
+
+    std::string compact;
+    doc.dump(compact);
+
+    json_options options;
+    options.indent_size(4);
+    std::string indented;
+    doc.dump(indented, options, indenting::indent);
+
+    std::size_t whitespace = indented.size() - compact.size();
+    std::cout << "compact:  " << compact.size() << " bytes\n";
+    std::cout << "indented: " << indented.size() << " bytes (" 
+              << (100 * whitespace / indented.size()) << "% whitespace)\n";
+#if defined(JSONCONS_NO_SIMD)
+    std::cout << "SIMD scanning disabled\n";
+#endif
+
+    const int repetitions = 10;
+    std::cout << "compact:  " << measure(compact, repetitions) << " MB/s\n";
+    std::cout << "indented: " << measure(indented, repetitions) << " MB/s\n";
+}
@@ -0,0 +1,106 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares json_parser and json_tape_parser throughput on a document held
+// in memory. Build with benchmarks/CMakeLists.txt.
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_tape_parser.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_document(std::size_t count)
+    {
+        json records(json_array_arg);
+        records.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json record;
+            record["id"] = i;
+            record["name"] = "record-" + std::to_string(i);
+            record["active"] = (i % 2) == 0;
+            json& address = record["address"] = json();
+            address["street"] = "1 Main Street";
+            address["city"] = "Toronto";
+            json& location = address["location"] = json();
+            location["lat"] = 43.65 + i*0.001;
+            location["lng"] = -79.38 - i*0.001;
+            json& tags = record["tags"] = json(json_array_arg);
+            tags.push_back("alpha");
+            tags.push_back("beta");
+            json& history = record["history"] = json(json_array_arg);
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                json event;
+                event["seq"] = j;
+                json& detail = event["detail"] = json();
+                detail["code"] = 200 + j;
+                history.push_back(std::move(event));
+            }
+            records.push_back(std::move(record));
+        }
+        json doc;
+        doc["records"] = std::move(records);
+        return doc;
+    }
+
+    template <class F>
+    double measure(const std::string& input, int repetitions, F parse)
+    {
+        double best = 0;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            parse(input);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            double mbps = input.size() / seconds / (1024.0 * 1024.0);
+            if (mbps > best)
+            {
+                best = mbps;
+            }
+        }
+        return best;
+    }
+
+} // namespace
+
+int main()
+{
+    json doc = make_document(20000);
+
+    std::string compact;
+    doc.dump(compact);
+
+    json_options options;
+    options.indent_size(4);
+    std::string indented;
+    doc.dump(indented, options, indenting::indent);
+
+    auto state_machine = [](const std::string& input)
+    {
+        basic_default_json_visitor<char> visitor;
+        json_parser parser;
+        parser.update(input.data(), input.size());
+        parser.finish_parse(visitor);
+        parser.check_done();
+    };
+    auto tape = [](const std::string& input)
+    {
+        basic_default_json_visitor<char> visitor;
+        json_tape_parser parser;
+        parser.parse(input, visitor);
+    };
+
+    const int repetitions = 10;
+    std::cout << "compact,  json_parser:      " << measure(compact, repetitions, state_machine) << " MB/s\n";
+    std::cout << "compact,  json_tape_parser: " << measure(compact, repetitions, tape) << " MB/s\n";
+    std::cout << "indented, json_parser:      " << measure(indented, repetitions, state_machine) << " MB/s\n";
+    std::cout << "indented, json_tape_parser: " << measure(indented, repetitions, tape) << " MB/s\n";
+}
@@ -0,0 +1,103 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Measures JSON parsing throughput from a std::istream whose reads have a
+// fixed latency, as on a cold cache or a network file system, with and
+// without prefetch_source.
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/prefetch_source.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Serves a string in blocks, waiting for a while before each block
+    class slow_buffer : public std::streambuf
+    {
+        std::string data_;
+        std::size_t offset_;
+        std::size_t block_size_;
+        std::chrono::microseconds latency_;
+    public:
+        slow_buffer(const std::string& data, std::size_t block_size, std::chrono::microseconds latency)
+            : data_(data), offset_(0), block_size_(block_size), latency_(latency)
+        {
+        }
+    protected:
+        int_type underflow() override
+        {
+            if (offset_ == data_.size())
+            {
+                return traits_type::eof();
+            }
+            std::this_thread::sleep_for(latency_);
+            std::size_t len = (std::min)(block_size_, data_.size() - offset_);
+            char* p = &data_[offset_];
+            setg(p, p, p + len);
+            offset_ += len;
+            return traits_type::to_int_type(*p);
+        }
+    };
+
+    std::string make_text(std::size_t count)
+    {
+        std::string s = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s += "{\"id\":" + std::to_string(i) + ",\"name\":\"record-" + std::to_string(i) + 
+                 "\",\"lat\":43.65,\"lng\":-79.38,\"active\":true}";
+        }
+        s.push_back(']');
+        return s;
+    }
+
+    template <class F>
+    double measure(std::size_t size, F f)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        f();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        return size / seconds / (1024.0 * 1024.0);
+    }
+
+} // namespace
+
+int main()
+{
+    std::string text = make_text(200000);
+    const std::size_t block_size = 16384;
+    const std::chrono::microseconds latency(100);
+
+    double stream_mbps = measure(text.size(), [&]()
+    {
+        slow_buffer buf(text, block_size, latency);
+        std::istream is(&buf);
+        basic_default_json_visitor<char> visitor;
+        basic_json_reader<char,stream_source<char>> reader(is, visitor);
+        reader.read();
+    });
+    double prefetch_mbps = measure(text.size(), [&]()
+    {
+        slow_buffer buf(text, block_size, latency);
+        std::istream is(&buf);
+        basic_default_json_visitor<char> visitor;
+        basic_json_reader<char,prefetch_source<stream_source<char>>> reader(prefetch_source<stream_source<char>>(is, block_size), visitor);
+        reader.read();
+    });
+
+    std::cout << "JSON text: " << text.size() << " bytes, " << latency.count() << "us per " << block_size << " byte read\n";
+    std::cout << "stream_source:   " << stream_mbps << " MB/s\n";
+    std::cout << "prefetch_source: " << prefetch_mbps << " MB/s\n";
+}
@@ -0,0 +1,240 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_ALLOCATOR_HPP
+#define JSONCONS_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint> // std::uintptr_t
+#include <limits> // std::numeric_limits
+#include <new> // ::operator new, std::bad_alloc
+#include <memory> // std::addressof
+#include <type_traits> // std::true_type
+#include <jsoncons/config/compiler_support.hpp>
+
+namespace jsoncons {
+
+// arena
+
+// A monotonic bump arena. Memory is handed out from chunks that grow geometrically,
+// deallocation does nothing, and everything is returned at once by release() or
+// the destructor, at a cost proportional to the number of chunks rather than
+// the number of allocations. An arena is not thread safe, and must outlive
+// anything allocated from it.
+class arena
+{
+    struct chunk
+    {
+        chunk* next;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t default_initial_chunk_size = 4096;
+    static constexpr std::size_t max_chunk_size = 16*1024*1024;
+
+    chunk* head_;
+    char* ptr_;
+    char* end_;
+    std::size_t initial_chunk_size_;
+    std::size_t next_chunk_size_;
+    std::size_t capacity_;
+    std::size_t allocated_;
+public:
+    explicit arena(std::size_t initial_chunk_size = default_initial_chunk_size)
+        : head_(nullptr), ptr_(nullptr), end_(nullptr),
+          initial_chunk_size_(initial_chunk_size > sizeof(chunk) ? round_up(initial_chunk_size) : std::size_t(default_initial_chunk_size)),
+          next_chunk_size_(initial_chunk_size_),
+          capacity_(0), allocated_(0)
+    {
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() noexcept
+    {
+        release();
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        char* p = align(ptr_, alignment);
+        // Aligning may move p past the end of the chunk
+        if (ptr_ == nullptr || p > end_ || size > static_cast<std::size_t>(end_ - p))
+        {
+            // size + alignment must not wrap, nor the chunk size computed from it
+            if (alignment > max_request_size() || size > max_request_size() - alignment)
+            {
+                JSONCONS_THROW(std::bad_alloc());
+            }
+            p = align(new_chunk(size + alignment), alignment);
+        }
+        ptr_ = p + size;
+        allocated_ += size;
+        return p;
+    }
+
+    // Frees all chunks, the arena can be used again afterwards
+    void release() noexcept
+    {
+        while (head_ != nullptr)
+        {
+            chunk* next = head_->next;
+            ::operator delete(head_);
+            head_ = next;
+        }
+        ptr_ = nullptr;
+        end_ = nullptr;
+        next_chunk_size_ = initial_chunk_size_;
+        capacity_ = 0;
+        allocated_ = 0;
+    }
+
+    // The number of bytes handed out since the last release
+    std::size_t allocated() const
+    {
+        return allocated_;
+    }
+
+    // The number of bytes held in chunks
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    // Chunk sizes are kept a multiple of the fundamental alignment
+    static std::size_t round_up(std::size_t size)
+    {
+        const std::size_t alignment = alignof(std::max_align_t);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // The largest min_size for which new_chunk can compute a chunk size
+    static constexpr std::size_t max_request_size()
+    {
+        return (std::numeric_limits<std::size_t>::max)() - sizeof(chunk) - alignof(std::max_align_t);
+    }
+
+    static char* align(char* p, std::size_t alignment)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+        return p + ((alignment - address % alignment) % alignment);
+    }
+
+    char* new_chunk(std::size_t min_size)
+    {
+        std::size_t size = next_chunk_size_;
+        while (size - sizeof(chunk) < min_size)
+        {
+            // Doubling stops where it would pass max_request_size()
+            size = size <= max_request_size()/2 ? size*2 : min_size + sizeof(chunk);
+        }
+        size = round_up(size);
+        chunk* c = static_cast<chunk*>(::operator new(size));
+        c->size = size;
+        c->next = head_;
+        head_ = c;
+        capacity_ += size;
+        if (next_chunk_size_ < max_chunk_size)
+        {
+            next_chunk_size_ *= 2;
+        }
+
+        ptr_ = reinterpret_cast<char*>(c) + sizeof(chunk);
+        end_ = reinterpret_cast<char*>(c) + size;
+        return ptr_;
+    }
+};
+
+// arena_allocator
+
+// An allocator that takes its memory from an arena, for building a basic_json value
+// with many small allocations, e.g. json_decoder<arena_json>, and dropping it all at once.
+// deallocate does nothing. A default constructed arena_allocator has no arena and
+// uses the global operator new and delete.
+template <class T>
+class arena_allocator
+{
+    template <class U>
+    friend class arena_allocator;
+
+    arena* arena_;
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <class U>
+    struct rebind
+    {
+        using other = arena_allocator<U>;
+    };
+
+    arena_allocator() noexcept
+        : arena_(nullptr)
+    {
+    }
+
+    explicit arena_allocator(arena& a) noexcept
+        : arena_(std::addressof(a))
+    {
+    }
+
+    arena_allocator(const arena_allocator&) = default;
+    arena_allocator& operator=(const arena_allocator&) = default;
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena_(other.arena_)
+    {
+    }
+
+    arena* get_arena() const noexcept
+    {
+        return arena_;
+    }
+
+    T* allocate(size_type n)
+    {
+        if (n > (std::numeric_limits<size_type>::max)()/sizeof(T))
+        {
+            JSONCONS_THROW(std::bad_alloc());
+        }
+        if (arena_ == nullptr)
+        {
+            return static_cast<T*>(::operator new(n*sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_type) noexcept
+    {
+        if (arena_ == nullptr)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    template <class U>
+    bool operator==(const arena_allocator<U>& other) const noexcept
+    {
+        return arena_ == other.arena_;
+    }
+
+    template <class U>
+    bool operator!=(const arena_allocator<U>& other) const noexcept
+    {
+        return arena_ != other.arena_;
+    }
+};
+
+} // namespace jsoncons
+
+#endif
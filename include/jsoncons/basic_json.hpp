@@ -21,6 +21,10 @@
 #include <utility> // std::move
 #include <type_traits> // std::enable_if
 #include <istream> // std::basic_istream
+#include <jsoncons/config/jsoncons_config.hpp>
+#if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
+#include <memory_resource> 
+#endif
 #include <jsoncons/json_fwd.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/config/version.hpp>
@@ -32,6 +36,7 @@
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_decoder.hpp>
+#include <jsoncons/arena_allocator.hpp>
 #include <jsoncons/json_reader.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/byte_string.hpp>
@@ -249,6 +254,14 @@ struct preserve_order_policy : public sorted_policy
     using key_order = preserve_key_order;
 };
 
+// Objects keep their members in insertion order, with a hash index for lookup, as
+// with preserve_order_policy, but two objects compare equal if they have the same 
+// members in any order.
+struct hashed_policy : public sorted_policy
+{
+    using key_order = hash_key_order;
+};
+
 template <class IteratorT, class ConstIteratorT>
 class range 
 {
@@ -3036,6 +3049,68 @@ public:
     {
     }
 
+private:
+    template <class... Args>
+    struct is_single_traits_arg : std::true_type {};
+
+    template <class Arg>
+    struct is_single_traits_arg<Arg>
+        : is_json_type_traits_specialized<basic_json,typename std::decay<Arg>::type> {};
+
+    // 0 if basic_json can be constructed from Args followed by a tag and allocator,
+    // 1 if from Args followed by an allocator, otherwise 2
+    template <class... Args>
+    struct uses_allocator_kind : std::integral_constant<int,
+        std::is_constructible<basic_json,Args&&...,semantic_tag,const Allocator&>::value ? 0 :
+        (std::is_constructible<basic_json,Args&&...,const Allocator&>::value && is_single_traits_arg<Args...>::value ? 1 : 2)>
+    {
+    };
+
+    template <class... Args>
+    static basic_json construct_with_allocator(std::integral_constant<int,0>, const Allocator& alloc, Args&&... args)
+    {
+        return basic_json(std::forward<Args>(args)..., semantic_tag::none, alloc);
+    }
+
+    template <class... Args>
+    static basic_json construct_with_allocator(std::integral_constant<int,1>, const Allocator& alloc, Args&&... args)
+    {
+        return basic_json(std::forward<Args>(args)..., alloc);
+    }
+
+    template <class... Args>
+    static basic_json construct_with_allocator(std::integral_constant<int,2>, const Allocator&, Args&&... args)
+    {
+        return basic_json(std::forward<Args>(args)...);
+    }
+public:
+
+    // Uses-allocator construction, as done by std::pmr::polymorphic_allocator. A copy 
+    // takes the given allocator. Other arguments are passed on with the allocator when
+    // basic_json can be constructed from them that way, so that a string or container
+    // made by emplace_back or try_emplace takes its memory from the container's allocator.
+
+    basic_json(std::allocator_arg_t, const Allocator& alloc, const basic_json& val)
+        : var_(val.var_,alloc)
+    {
+    }
+
+    basic_json(std::allocator_arg_t, const Allocator& alloc, basic_json& val)
+        : var_(val.var_,alloc)
+    {
+    }
+
+    basic_json(std::allocator_arg_t, const Allocator&, basic_json&& other) noexcept
+        : var_(std::move(other.var_))
+    {
+    }
+
+    template <class... Args>
+    basic_json(std::allocator_arg_t, const Allocator& alloc, Args&&... args)
+        : basic_json(construct_with_allocator(uses_allocator_kind<Args...>(), alloc, std::forward<Args>(args)...))
+    {
+    }
+
     explicit basic_json(json_object_arg_t, 
                         semantic_tag tag = semantic_tag::none,
                         const Allocator& alloc = Allocator()) 
@@ -5515,6 +5590,21 @@ using wjson = basic_json<wchar_t,sorted_policy,std::allocator<char>>;
 using ojson = basic_json<char, preserve_order_policy, std::allocator<char>>;
 using wojson = basic_json<wchar_t, preserve_order_policy, std::allocator<char>>;
 
+// Values that take their memory from an arena, see arena_allocator
+using arena_json = basic_json<char,sorted_policy,arena_allocator<char>>;
+using arena_ojson = basic_json<char,preserve_order_policy,arena_allocator<char>>;
+
+#if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
+namespace pmr {
+    template< class CharT, class Policy>
+    using basic_json = jsoncons::basic_json<CharT, Policy, std::pmr::polymorphic_allocator<char>>;
+    using json = basic_json<char,sorted_policy>;
+    using wjson = basic_json<wchar_t,sorted_policy>;
+    using ojson = basic_json<char, preserve_order_policy>;
+    using wojson = basic_json<wchar_t, preserve_order_policy>;
+}
+#endif
+
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use wojson") typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> owjson;
 JSONCONS_DEPRECATED_MSG("Instead, use json_decoder<json>") typedef json_decoder<json> json_deserializer;
@@ -0,0 +1,455 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSED_SOURCE_HPP
+#define JSONCONS_COMPRESSED_SOURCE_HPP
+
+// gzip_source and binary_gzip_source require zlib and JSONCONS_HAS_ZLIB,
+// zstd_source and binary_zstd_source require libzstd and JSONCONS_HAS_ZSTD.
+// The CMake option JSONCONS_WITH_ZLIB defines JSONCONS_HAS_ZLIB and links zlib
+// for targets that use jsoncons. JSONCONS_HAS_ZSTD is left to the consumer, who
+// also links libzstd.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <istream>
+#include <memory> // std::addressof
+#include <vector>
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/detail/span.hpp>
+
+#if defined(JSONCONS_HAS_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(JSONCONS_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    enum class decompress_status {ok, stream_end, error};
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+    // Decompresses gzip or zlib data, the format is detected from the header
+    class gzip_decompressor
+    {
+        z_stream strm_;
+        bool initialized_;
+
+        // Noncopyable and nonmoveable
+        gzip_decompressor(const gzip_decompressor&) = delete;
+        gzip_decompressor& operator=(const gzip_decompressor&) = delete;
+    public:
+        gzip_decompressor()
+            : strm_(), initialized_(false)
+        {
+            // 15 is the largest window, adding 32 detects gzip or zlib headers
+            initialized_ = inflateInit2(&strm_, 15 + 32) == Z_OK;
+        }
+
+        ~gzip_decompressor() noexcept
+        {
+            if (initialized_)
+            {
+                inflateEnd(&strm_);
+            }
+        }
+
+        // Prepares for the next gzip member of a concatenated stream
+        bool reset()
+        {
+            return initialized_ && inflateReset(&strm_) == Z_OK;
+        }
+
+        decompress_status decompress(const uint8_t* in, std::size_t in_length, std::size_t& in_used,
+                                     uint8_t* out, std::size_t out_length, std::size_t& out_used)
+        {
+            in_used = 0;
+            out_used = 0;
+            if (!initialized_)
+            {
+                return decompress_status::error;
+            }
+            // avail_in and avail_out are 32 bit
+            const std::size_t max_length = 1u << 30;
+            strm_.next_in = const_cast<Bytef*>(in);
+            strm_.avail_in = static_cast<uInt>((std::min)(in_length, max_length));
+            strm_.next_out = out;
+            strm_.avail_out = static_cast<uInt>((std::min)(out_length, max_length));
+
+            int rc = inflate(&strm_, Z_NO_FLUSH);
+            in_used = strm_.next_in - in;
+            out_used = strm_.next_out - out;
+            switch (rc)
+            {
+                case Z_OK:
+                    return decompress_status::ok;
+                case Z_STREAM_END:
+                    return decompress_status::stream_end;
+                case Z_BUF_ERROR: // no progress possible, more input is needed
+                    return decompress_status::ok;
+                default:
+                    return decompress_status::error;
+            }
+        }
+    };
+
+#endif // defined(JSONCONS_HAS_ZLIB)
+
+#if defined(JSONCONS_HAS_ZSTD)
+
+    // Decompresses zstd data
+    class zstd_decompressor
+    {
+        ZSTD_DStream* stream_;
+
+        // Noncopyable and nonmoveable
+        zstd_decompressor(const zstd_decompressor&) = delete;
+        zstd_decompressor& operator=(const zstd_decompressor&) = delete;
+    public:
+        zstd_decompressor()
+            : stream_(ZSTD_createDStream())
+        {
+            if (stream_ != nullptr && ZSTD_isError(ZSTD_initDStream(stream_)))
+            {
+                ZSTD_freeDStream(stream_);
+                stream_ = nullptr;
+            }
+        }
+
+        ~zstd_decompressor() noexcept
+        {
+            if (stream_ != nullptr)
+            {
+                ZSTD_freeDStream(stream_);
+            }
+        }
+
+        // Frames that follow each other are decoded without a reset
+        bool reset()
+        {
+            return stream_ != nullptr;
+        }
+
+        decompress_status decompress(const uint8_t* in, std::size_t in_length, std::size_t& in_used,
+                                     uint8_t* out, std::size_t out_length, std::size_t& out_used)
+        {
+            in_used = 0;
+            out_used = 0;
+            if (stream_ == nullptr)
+            {
+                return decompress_status::error;
+            }
+            ZSTD_inBuffer input = {in, in_length, 0};
+            ZSTD_outBuffer output = {out, out_length, 0};
+            std::size_t rc = ZSTD_decompressStream(stream_, &output, &input);
+            in_used = input.pos;
+            out_used = output.pos;
+            if (ZSTD_isError(rc))
+            {
+                return decompress_status::error;
+            }
+            // 0 means a frame is complete and fully flushed
+            return rc == 0 ? decompress_status::stream_end : decompress_status::ok;
+        }
+    };
+
+#endif // defined(JSONCONS_HAS_ZSTD)
+
+} // namespace detail
+
+    // compressed_source
+
+    // Reads compressed data from a stream and decompresses it in blocks. read()
+    // decompresses straight into the caller's buffer, the reader's buffer for
+    // basic_json_reader, basic_json_cursor and basic_csv_reader, so memory use is bounded
+    // by the block size whatever the size of the uncompressed data. get_character(),
+    // peek_character(), ignore() and read_view(), used by the binary parsers, work
+    // from a block sized output buffer.
+    //
+    // Concatenated streams (gzip members, zstd frames) are read one after another.
+    // Corrupt or truncated data ends the input, and is_error() becomes true.
+    //
+    // CharT must be a single byte type, the decompressed bytes are the characters.
+    template <class CharT,class Decompressor>
+    class compressed_source
+    {
+    public:
+        using value_type = CharT;
+        static constexpr std::size_t default_block_size = 16384;
+    private:
+        static_assert(sizeof(CharT) == 1, "compressed_source requires a single byte character type");
+
+        basic_null_istream<char> null_is_;
+        std::istream* stream_ptr_;
+        std::unique_ptr<Decompressor> decompressor_;
+        std::vector<uint8_t> input_;
+        std::size_t input_begin_;
+        std::size_t input_end_;
+        std::vector<value_type> output_;
+        std::size_t output_begin_;
+        std::size_t output_end_;
+        std::size_t position_;
+        bool stream_end_;   // the last decompressed stream is complete
+        bool done_;         // no more output
+        bool error_;
+
+        // Noncopyable
+        compressed_source(const compressed_source&) = delete;
+        compressed_source& operator=(const compressed_source&) = delete;
+    public:
+        compressed_source()
+            : stream_ptr_(&null_is_), input_begin_(0), input_end_(0),
+              output_begin_(0), output_end_(0), position_(0),
+              stream_end_(true), done_(true), error_(false)
+        {
+        }
+
+        compressed_source(std::istream& is, std::size_t block_size = default_block_size)
+            : stream_ptr_(std::addressof(is)), decompressor_(new Decompressor()),
+              input_(block_size > 0 ? block_size : 1), input_begin_(0), input_end_(0),
+              output_(block_size > 0 ? block_size : 1), output_begin_(0), output_end_(0), position_(0),
+              stream_end_(false), done_(false), error_(!decompressor_->reset())
+        {
+        }
+
+        compressed_source(compressed_source&& other) noexcept
+            : stream_ptr_(&null_is_), input_begin_(0), input_end_(0),
+              output_begin_(0), output_end_(0), position_(0),
+              stream_end_(true), done_(true), error_(false)
+        {
+            swap(other);
+        }
+
+        compressed_source& operator=(compressed_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return output_begin_ == output_end_ && done_;
+        }
+
+        bool is_error() const
+        {
+            return error_ || stream_ptr_->bad();
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (output_begin_ == output_end_ && fill() == 0)
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(output_[output_begin_++]);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0 && (output_begin_ < output_end_ || fill() > 0))
+            {
+                std::size_t len = (std::min)(count, output_end_ - output_begin_);
+                output_begin_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (output_begin_ == output_end_ && fill() == 0)
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(output_[output_begin_]);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = (std::min)(length, output_end_ - output_begin_);
+            std::memcpy(p, output_.data() + output_begin_, count);
+            output_begin_ += count;
+            while (count < length)
+            {
+                std::size_t n = decompress(reinterpret_cast<uint8_t*>(p + count), length - count);
+                if (n == 0)
+                {
+                    break;
+                }
+                count += n;
+            }
+            position_ += count;
+            return count;
+        }
+
+        // Returns the next length bytes, or fewer if the input ends first. The bytes
+        // remain valid until the next call on the source.
+        jsoncons::detail::span<const value_type> read_view(std::size_t length)
+        {
+            if (output_end_ - output_begin_ < length)
+            {
+                if (length > output_.size())
+                {
+                    output_.resize(length);
+                }
+                while (output_end_ - output_begin_ < length && fill() > 0)
+                {
+                }
+            }
+            std::size_t count = (std::min)(length, output_end_ - output_begin_);
+            jsoncons::detail::span<const value_type> s(output_.data() + output_begin_, count);
+            output_begin_ += count;
+            position_ += count;
+            return s;
+        }
+
+    private:
+        void swap(compressed_source& other) noexcept
+        {
+            // A source that reads from its own null stream must keep reading from it
+            bool this_null = stream_ptr_ == &null_is_;
+            bool other_null = other.stream_ptr_ == &other.null_is_;
+            std::swap(stream_ptr_,other.stream_ptr_);
+            if (other_null)
+            {
+                stream_ptr_ = &null_is_;
+            }
+            if (this_null)
+            {
+                other.stream_ptr_ = &other.null_is_;
+            }
+            decompressor_.swap(other.decompressor_);
+            input_.swap(other.input_);
+            std::swap(input_begin_,other.input_begin_);
+            std::swap(input_end_,other.input_end_);
+            output_.swap(other.output_);
+            std::swap(output_begin_,other.output_begin_);
+            std::swap(output_end_,other.output_end_);
+            std::swap(position_,other.position_);
+            std::swap(stream_end_,other.stream_end_);
+            std::swap(done_,other.done_);
+            std::swap(error_,other.error_);
+        }
+
+        // Moves the unread output to the front of the output buffer and decompresses
+        // more after it, returns the number of bytes added
+        std::size_t fill()
+        {
+            if (output_begin_ > 0)
+            {
+                std::memmove(output_.data(), output_.data() + output_begin_, output_end_ - output_begin_);
+                output_end_ -= output_begin_;
+                output_begin_ = 0;
+            }
+            std::size_t count = decompress(reinterpret_cast<uint8_t*>(output_.data() + output_end_), output_.size() - output_end_);
+            output_end_ += count;
+            return count;
+        }
+
+        // Decompresses at most length bytes into p, reading compressed input as needed.
+        // Returns the number of bytes decompressed, 0 at the end of the input.
+        std::size_t decompress(uint8_t* p, std::size_t length)
+        {
+            while (!done_ && length > 0)
+            {
+                if (input_begin_ == input_end_ && !read_input())
+                {
+                    // A stream that is cut short is an error
+                    error_ = error_ || !stream_end_;
+                    done_ = true;
+                    break;
+                }
+                if (stream_end_)
+                {
+                    // More data follows a complete stream
+                    if (!decompressor_->reset())
+                    {
+                        error_ = done_ = true;
+                        break;
+                    }
+                    stream_end_ = false;
+                }
+                std::size_t in_used = 0;
+                std::size_t out_used = 0;
+                auto status = decompressor_->decompress(input_.data() + input_begin_, input_end_ - input_begin_, in_used,
+                                                        p, length, out_used);
+                input_begin_ += in_used;
+                if (status == jsoncons::detail::decompress_status::error ||
+                    (status == jsoncons::detail::decompress_status::ok && in_used == 0 && out_used == 0))
+                {
+                    error_ = done_ = true;
+                    break;
+                }
+                if (status == jsoncons::detail::decompress_status::stream_end)
+                {
+                    stream_end_ = true;
+                }
+                if (out_used > 0)
+                {
+                    return out_used;
+                }
+            }
+            return 0;
+        }
+
+        bool read_input()
+        {
+            if (stream_ptr_->bad())
+            {
+                return false;
+            }
+            JSONCONS_TRY
+            {
+                std::streamsize count = stream_ptr_->rdbuf()->sgetn(reinterpret_cast<char*>(input_.data()), input_.size());
+                input_begin_ = 0;
+                input_end_ = static_cast<std::size_t>(count);
+                if (input_end_ < input_.size())
+                {
+                    stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+                }
+                return input_end_ > 0;
+            }
+            JSONCONS_CATCH(const std::exception&)
+            {
+                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
+                return false;
+            }
+        }
+    };
+
+    template <class CharT,class Decompressor>
+    constexpr std::size_t compressed_source<CharT,Decompressor>::default_block_size;
+
+#if defined(JSONCONS_HAS_ZLIB)
+    template <class CharT>
+    using gzip_source = compressed_source<CharT,jsoncons::detail::gzip_decompressor>;
+    using binary_gzip_source = compressed_source<uint8_t,jsoncons::detail::gzip_decompressor>;
+#endif
+
+#if defined(JSONCONS_HAS_ZSTD)
+    template <class CharT>
+    using zstd_source = compressed_source<CharT,jsoncons::detail::zstd_decompressor>;
+    using binary_zstd_source = compressed_source<uint8_t,jsoncons::detail::zstd_decompressor>;
+#endif
+
+} // namespace jsoncons
+
+#endif
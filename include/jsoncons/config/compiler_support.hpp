@@ -156,6 +156,14 @@
 #  endif // defined(JSONCONS_HAS_2017)
 #endif // !defined(JSONCONS_HAS_FILESYSTEM)
 
+#if !defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
+#  if (defined JSONCONS_HAS_2017) && defined(__has_include)
+#    if __has_include(<memory_resource>)
+#      define JSONCONS_HAS_POLYMORPHIC_ALLOCATOR 1
+#    endif // __has_include(<memory_resource>)
+#  endif // defined(JSONCONS_HAS_2017)
+#endif // !defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
+
 #if (!defined(JSONCONS_NO_EXCEPTIONS))
 // Check if exceptions are disabled.
 #  if defined( __cpp_exceptions) && __cpp_exceptions == 0
@@ -226,5 +234,44 @@
 #  define JSONCONS_CPP14_CONSTEXPR
 #endif
 
+// Define JSONCONS_NO_SIMD to force the scalar scanning code paths
+#if !defined(JSONCONS_NO_SIMD)
+#  if !defined(JSONCONS_HAS_AVX2) && defined(__AVX2__)
+#    define JSONCONS_HAS_AVX2 1
+#  endif
+#  if !defined(JSONCONS_HAS_SSE2)
+#    if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#      define JSONCONS_HAS_SSE2 1
+#    endif
+#  endif
+#  if !defined(JSONCONS_HAS_NEON)
+#    if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#      define JSONCONS_HAS_NEON 1
+#    endif
+#  endif
+#endif // !defined(JSONCONS_NO_SIMD)
+
+// Define JSONCONS_NO_MMAP to leave out the memory mapped file sources
+#if !defined(JSONCONS_NO_MMAP)
+#  if !defined(JSONCONS_HAS_WINDOWS_MMAP) && defined(_WIN32)
+#    define JSONCONS_HAS_WINDOWS_MMAP 1
+#  endif
+#  if !defined(JSONCONS_HAS_POSIX_MMAP) && !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#    define JSONCONS_HAS_POSIX_MMAP 1
+#  endif
+#  if defined(JSONCONS_HAS_WINDOWS_MMAP) || defined(JSONCONS_HAS_POSIX_MMAP)
+#    define JSONCONS_HAS_MMAP 1
+#  endif
+#endif // !defined(JSONCONS_NO_MMAP)
+
+// Define JSONCONS_NO_COROUTINES to leave out the coroutine readers
+#if !defined(JSONCONS_NO_COROUTINES) && !defined(JSONCONS_HAS_COROUTINES)
+#  if defined(__cpp_impl_coroutine) && defined(__has_include)
+#    if __has_include(<coroutine>)
+#      define JSONCONS_HAS_COROUTINES 1
+#    endif
+#  endif
+#endif // !defined(JSONCONS_NO_COROUTINES)
+
 #endif // JSONCONS_COMPILER_SUPPORT_HPP
 
@@ -0,0 +1,184 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COUNTING_ALLOCATOR_HPP
+#define JSONCONS_COUNTING_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator, std::allocator_traits
+#include <type_traits> // std::true_type
+
+namespace jsoncons {
+
+// allocation_budget
+
+// Counts the bytes held by the counting_allocators that share it, against a limit.
+// An allocation that takes the count past the limit still succeeds, but marks the
+// budget as exceeded, json_decoder checks for that after each value and stops with
+// json_errc::max_allocation_exceeded. The budget is not thread safe, and must outlive
+// the allocators that use it.
+class allocation_budget
+{
+    std::size_t limit_;
+    std::size_t allocated_;
+    std::size_t peak_;
+    bool exceeded_;
+public:
+    explicit allocation_budget(std::size_t limit = (std::numeric_limits<std::size_t>::max)())
+        : limit_(limit), allocated_(0), peak_(0), exceeded_(false)
+    {
+    }
+
+    allocation_budget(const allocation_budget&) = delete;
+    allocation_budget& operator=(const allocation_budget&) = delete;
+
+    std::size_t limit() const
+    {
+        return limit_;
+    }
+
+    // The number of bytes currently allocated
+    std::size_t allocated() const
+    {
+        return allocated_;
+    }
+
+    // The largest number of bytes allocated at one time
+    std::size_t peak() const
+    {
+        return peak_;
+    }
+
+    bool exceeded() const
+    {
+        return exceeded_;
+    }
+
+    void acquire(std::size_t n)
+    {
+        allocated_ += n;
+        if (allocated_ > peak_)
+        {
+            peak_ = allocated_;
+        }
+        if (allocated_ > limit_)
+        {
+            exceeded_ = true;
+        }
+    }
+
+    void release(std::size_t n)
+    {
+        allocated_ -= n;
+    }
+};
+
+// counting_allocator
+
+// An allocator that counts the bytes it allocates against an allocation_budget, and
+// gets its memory from another allocator. A default constructed counting_allocator
+// has no budget and counts nothing.
+template <class T, class Allocator = std::allocator<T>>
+class counting_allocator
+{
+    template <class U, class A>
+    friend class counting_allocator;
+
+    using traits_type = typename std::allocator_traits<Allocator>:: template rebind_traits<T>;
+    using allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<T>;
+
+    allocator_type alloc_;
+    allocation_budget* budget_;
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <class U>
+    struct rebind
+    {
+        using other = counting_allocator<U,typename std::allocator_traits<Allocator>:: template rebind_alloc<U>>;
+    };
+
+    counting_allocator() noexcept
+        : alloc_(), budget_(nullptr)
+    {
+    }
+
+    explicit counting_allocator(allocation_budget& budget, const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc), budget_(std::addressof(budget))
+    {
+    }
+
+    counting_allocator(const counting_allocator&) = default;
+    counting_allocator& operator=(const counting_allocator&) = default;
+
+    template <class U, class A>
+    counting_allocator(const counting_allocator<U,A>& other) noexcept
+        : alloc_(other.alloc_), budget_(other.budget_)
+    {
+    }
+
+    allocation_budget* budget() const noexcept
+    {
+        return budget_;
+    }
+
+    T* allocate(size_type n)
+    {
+        T* p = traits_type::allocate(alloc_, n);
+        if (budget_ != nullptr)
+        {
+            budget_->acquire(n*sizeof(T));
+        }
+        return p;
+    }
+
+    void deallocate(T* p, size_type n) noexcept
+    {
+        traits_type::deallocate(alloc_, p, n);
+        if (budget_ != nullptr)
+        {
+            budget_->release(n*sizeof(T));
+        }
+    }
+
+    template <class U, class A>
+    bool operator==(const counting_allocator<U,A>& other) const noexcept
+    {
+        return budget_ == other.budget_ && alloc_ == other.alloc_;
+    }
+
+    template <class U, class A>
+    bool operator!=(const counting_allocator<U,A>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+namespace detail {
+
+    template <class Allocator>
+    bool allocation_budget_exceeded(const Allocator&) noexcept
+    {
+        return false;
+    }
+
+    template <class T, class A>
+    bool allocation_budget_exceeded(const counting_allocator<T,A>& alloc) noexcept
+    {
+        return alloc.budget() != nullptr && alloc.budget()->exceeded();
+    }
+
+} // namespace detail
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,463 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_INDEX_HPP
+#define JSONCONS_DETAIL_HASH_INDEX_HPP
+
+#include <algorithm> // std::equal
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::allocator_traits
+#include <type_traits> // std::make_unsigned
+#include <utility> // std::move
+#include <vector>
+
+namespace jsoncons {
+namespace detail {
+
+    // FNV-1a over the code units of a key, followed by a 64 bit finalizer so that
+    // the low bits that select a slot depend on the whole key
+    template <class CharT>
+    std::size_t hash_key(const CharT* s, std::size_t length) noexcept
+    {
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+        uint64_t h = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint64_t>(static_cast<unsigned_type>(s[i]));
+            h *= 1099511628211ULL;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    // hash_index
+
+    // A compact open addressing (linear probing) index of the positions of the members 
+    // of an object, after the dictionaries of CPython. The members are kept by the object 
+    // in a dense sequence, in insertion order, and passed to each operation. A slot holds 
+    // a position plus one, zero marks an empty slot, and slots are 1, 2, 4 or 8 bytes wide
+    // depending on the number of slots. Objects with no more than max_unindexed_size 
+    // members have no slots and are searched linearly.
+    template <class Allocator>
+    class hash_index
+    {
+    public:
+        using allocator_type = Allocator;
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+        static constexpr std::size_t max_unindexed_size = 8;
+    private:
+        using byte_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t>;
+
+        std::vector<uint8_t,byte_allocator_type> slots_;
+        std::size_t capacity_;
+        std::size_t width_;
+    public:
+        hash_index()
+            : capacity_(0), width_(1)
+        {
+        }
+
+        explicit hash_index(const allocator_type& alloc)
+            : slots_(byte_allocator_type(alloc)), capacity_(0), width_(1)
+        {
+        }
+
+        hash_index(const hash_index& other) = default;
+
+        hash_index(hash_index&& other) noexcept
+            : slots_(std::move(other.slots_)), capacity_(other.capacity_), width_(other.width_)
+        {
+            other.capacity_ = 0;
+            other.width_ = 1;
+        }
+
+        hash_index(const hash_index& other, const allocator_type& alloc)
+            : slots_(other.slots_, byte_allocator_type(alloc)), capacity_(other.capacity_), width_(other.width_)
+        {
+        }
+
+        hash_index(hash_index&& other, const allocator_type& alloc)
+            : slots_(std::move(other.slots_), byte_allocator_type(alloc)), capacity_(other.capacity_), width_(other.width_)
+        {
+            other.slots_.clear();
+            other.capacity_ = 0;
+            other.width_ = 1;
+        }
+
+        hash_index& operator=(const hash_index& other) = default;
+
+        hash_index& operator=(hash_index&& other) noexcept
+        {
+            if (this != &other)
+            {
+                slots_ = std::move(other.slots_);
+                capacity_ = other.capacity_;
+                width_ = other.width_;
+                other.slots_.clear();
+                other.capacity_ = 0;
+                other.width_ = 1;
+            }
+            return *this;
+        }
+
+        void swap(hash_index& other) noexcept
+        {
+            slots_.swap(other.slots_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(width_, other.width_);
+        }
+
+        void clear() noexcept
+        {
+            slots_.clear();
+            capacity_ = 0;
+            width_ = 1;
+        }
+
+        void shrink_to_fit()
+        {
+            slots_.shrink_to_fit();
+        }
+
+        // The number of slots
+        std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        // The number of bytes in a slot
+        std::size_t slot_width() const noexcept
+        {
+            return width_;
+        }
+
+        // Returns the position of the member with the given name, or npos
+        template <class Members, class String>
+        std::size_t find(const Members& members, const String& name) const
+        {
+            if (capacity_ == 0)
+            {
+                for (std::size_t i = 0; i < members.size(); ++i)
+                {
+                    if (equal(members[i].key(), name))
+                    {
+                        return i;
+                    }
+                }
+                return npos;
+            }
+            std::size_t value = get(find_slot(members, name));
+            return value == 0 ? npos : value - 1;
+        }
+
+        // Indexes the member just inserted at pos, after the members at pos and above
+        // have been shifted up one. The name must not already be indexed.
+        template <class Members>
+        void insert(const Members& members, std::size_t pos)
+        {
+            if (members.size() <= max_unindexed_size)
+            {
+                return;
+            }
+            if (capacity_ == 0 || 3*members.size() > 2*capacity_)
+            {
+                build(members);
+                return;
+            }
+            if (pos + 1 < members.size())
+            {
+                shift(pos + 1, 1);
+            }
+            place(members, pos);
+        }
+
+        // Removes the members at [pos1,pos2) from the index, before they are erased
+        template <class Members>
+        void erase(const Members& members, std::size_t pos1, std::size_t pos2)
+        {
+            if (pos1 >= pos2)
+            {
+                return;
+            }
+            if (members.size() - (pos2 - pos1) <= max_unindexed_size)
+            {
+                clear();
+                return;
+            }
+            for (std::size_t pos = pos1; pos < pos2; ++pos)
+            {
+                remove_slot(members, find_slot(members, members[pos].key()));
+            }
+            if (pos2 < members.size())
+            {
+                shift(pos2 + 1, static_cast<std::size_t>(0) - (pos2 - pos1));
+            }
+        }
+
+        // Rebuilds the index for members with unique names
+        template <class Members>
+        void build(const Members& members)
+        {
+            if (members.size() <= max_unindexed_size)
+            {
+                clear();
+                return;
+            }
+            reset(capacity_for(members.size()));
+            for (std::size_t pos = 0; pos < members.size(); ++pos)
+            {
+                place(members, pos);
+            }
+        }
+
+        // Erases all but the first member with each name, keeping the order of
+        // the remaining members, and rebuilds the index
+        template <class Members>
+        void build_unique(Members& members)
+        {
+            std::size_t count = 0;
+            if (members.size() <= max_unindexed_size)
+            {
+                clear();
+                for (std::size_t i = 0; i < members.size(); ++i)
+                {
+                    std::size_t j = 0;
+                    while (j < count && !equal(members[j].key(), members[i].key()))
+                    {
+                        ++j;
+                    }
+                    if (j == count)
+                    {
+                        move_member(members, i, count++);
+                    }
+                }
+            }
+            else
+            {
+                // Only the members kept so far, at [0,count), are indexed
+                reset(capacity_for(members.size()));
+                for (std::size_t i = 0; i < members.size(); ++i)
+                {
+                    std::size_t slot = find_slot(members, members[i].key());
+                    if (get(slot) == 0)
+                    {
+                        move_member(members, i, count);
+                        set(slot, ++count);
+                    }
+                }
+            }
+            if (count < members.size())
+            {
+                members.erase(members.begin() + count, members.end());
+                if (count <= max_unindexed_size)
+                {
+                    clear();
+                }
+            }
+        }
+
+    private:
+        // A power of two that keeps the load factor at no more than 2/3
+        static std::size_t capacity_for(std::size_t size) noexcept
+        {
+            std::size_t capacity = 16;
+            while (2*capacity < 3*size)
+            {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        // Slot values are less than the capacity
+        static std::size_t width_for(std::size_t capacity) noexcept
+        {
+            if (capacity <= 0x100)
+            {
+                return 1;
+            }
+            if (capacity <= 0x10000)
+            {
+                return 2;
+            }
+            if (capacity <= 0xFFFFFFFF)
+            {
+                return 4;
+            }
+            return 8;
+        }
+
+        void reset(std::size_t capacity)
+        {
+            width_ = width_for(capacity);
+            capacity_ = capacity;
+            slots_.assign(capacity*width_, 0);
+        }
+
+        std::size_t get(std::size_t i) const noexcept
+        {
+            const uint8_t* p = slots_.data() + i*width_;
+            switch (width_)
+            {
+                case 1:
+                    return *p;
+                case 2:
+                {
+                    uint16_t value;
+                    std::memcpy(&value, p, sizeof(value));
+                    return value;
+                }
+                case 4:
+                {
+                    uint32_t value;
+                    std::memcpy(&value, p, sizeof(value));
+                    return value;
+                }
+                default:
+                {
+                    uint64_t value;
+                    std::memcpy(&value, p, sizeof(value));
+                    return static_cast<std::size_t>(value);
+                }
+            }
+        }
+
+        void set(std::size_t i, std::size_t value) noexcept
+        {
+            uint8_t* p = slots_.data() + i*width_;
+            switch (width_)
+            {
+                case 1:
+                    *p = static_cast<uint8_t>(value);
+                    break;
+                case 2:
+                {
+                    uint16_t v = static_cast<uint16_t>(value);
+                    std::memcpy(p, &v, sizeof(v));
+                    break;
+                }
+                case 4:
+                {
+                    uint32_t v = static_cast<uint32_t>(value);
+                    std::memcpy(p, &v, sizeof(v));
+                    break;
+                }
+                default:
+                {
+                    uint64_t v = value;
+                    std::memcpy(p, &v, sizeof(v));
+                    break;
+                }
+            }
+        }
+
+        template <class Members>
+        static void move_member(Members& members, std::size_t from, std::size_t to)
+        {
+            if (from != to)
+            {
+                members[to] = std::move(members[from]);
+            }
+        }
+
+        template <class StringA, class StringB>
+        static bool equal(const StringA& a, const StringB& b) noexcept
+        {
+            return a.size() == b.size() && std::equal(a.data(), a.data() + a.size(), b.data());
+        }
+
+        template <class String>
+        static std::size_t hash_of(const String& s) noexcept
+        {
+            return hash_key(s.data(), s.size());
+        }
+
+        // Returns the slot holding the member with the given name, or the empty slot
+        // where it would go
+        template <class Members, class String>
+        std::size_t find_slot(const Members& members, const String& name) const
+        {
+            const std::size_t mask = capacity_ - 1;
+            std::size_t i = hash_of(name) & mask;
+            std::size_t value;
+            while ((value = get(i)) != 0)
+            {
+                if (equal(members[value - 1].key(), name))
+                {
+                    break;
+                }
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        template <class Members>
+        void place(const Members& members, std::size_t pos)
+        {
+            const std::size_t mask = capacity_ - 1;
+            std::size_t i = hash_of(members[pos].key()) & mask;
+            while (get(i) != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            set(i, pos + 1);
+        }
+
+        // Empties a slot, moving later members of its cluster back so that no
+        // probe sequence is broken
+        template <class Members>
+        void remove_slot(const Members& members, std::size_t i)
+        {
+            const std::size_t mask = capacity_ - 1;
+            std::size_t j = i;
+            while (true)
+            {
+                j = (j + 1) & mask;
+                std::size_t value = get(j);
+                if (value == 0)
+                {
+                    break;
+                }
+                std::size_t home = hash_of(members[value - 1].key()) & mask;
+                // Move slot j to i unless its home lies cyclically in (i,j]
+                bool in_between = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+                if (!in_between)
+                {
+                    set(i, value);
+                    i = j;
+                }
+            }
+            set(i, 0);
+        }
+
+        // Adds delta (modulo 2^N) to the slots that hold a value of at least first
+        void shift(std::size_t first, std::size_t delta) noexcept
+        {
+            for (std::size_t i = 0; i < capacity_; ++i)
+            {
+                std::size_t value = get(i);
+                if (value >= first)
+                {
+                    set(i, value + delta);
+                }
+            }
+        }
+    };
+
+    template <class Allocator>
+    constexpr std::size_t hash_index<Allocator>::npos;
+
+    template <class Allocator>
+    constexpr std::size_t hash_index<Allocator>::max_unindexed_size;
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
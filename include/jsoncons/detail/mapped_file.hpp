@@ -0,0 +1,214 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_MAPPED_FILE_HPP
+#define JSONCONS_DETAIL_MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility> // std::swap
+#include <jsoncons/config/compiler_support.hpp>
+
+#if defined(JSONCONS_HAS_POSIX_MMAP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(JSONCONS_HAS_WINDOWS_MMAP)
+#include <windows.h>
+#endif
+
+#if defined(JSONCONS_HAS_MMAP)
+
+namespace jsoncons {
+namespace detail {
+
+    // A read only view of a whole file mapped into memory. The file is mapped with
+    // hints that it will be read sequentially and soon. If the file cannot be opened
+    // or mapped, is_open() is false.
+
+    class mapped_file
+    {
+        const uint8_t* data_;
+        std::size_t size_;
+        bool is_open_;
+#if defined(JSONCONS_HAS_WINDOWS_MMAP)
+        HANDLE file_;
+        HANDLE mapping_;
+#endif
+
+        // Noncopyable
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+    public:
+        mapped_file() noexcept
+            : data_(nullptr), size_(0), is_open_(false)
+#if defined(JSONCONS_HAS_WINDOWS_MMAP)
+              , file_(INVALID_HANDLE_VALUE), mapping_(nullptr)
+#endif
+        {
+        }
+
+        explicit mapped_file(const std::string& path) noexcept
+            : mapped_file()
+        {
+            open(path);
+        }
+
+        mapped_file(mapped_file&& other) noexcept
+            : mapped_file()
+        {
+            swap(other);
+        }
+
+        ~mapped_file() noexcept
+        {
+            close();
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(mapped_file& other) noexcept
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(is_open_, other.is_open_);
+#if defined(JSONCONS_HAS_WINDOWS_MMAP)
+            std::swap(file_, other.file_);
+            std::swap(mapping_, other.mapping_);
+#endif
+        }
+
+        bool is_open() const
+        {
+            return is_open_;
+        }
+
+        const uint8_t* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+#if defined(JSONCONS_HAS_POSIX_MMAP)
+        void open(const std::string& path) noexcept
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                return;
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ > 0)
+            {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    size_ = 0;
+                    ::close(fd);
+                    return;
+                }
+#if defined(POSIX_MADV_SEQUENTIAL) && defined(POSIX_MADV_WILLNEED)
+                ::posix_madvise(p, size_, POSIX_MADV_SEQUENTIAL);
+                ::posix_madvise(p, size_, POSIX_MADV_WILLNEED);
+#endif
+                data_ = static_cast<const uint8_t*>(p);
+            }
+            // The mapping stays valid after the descriptor is closed
+            ::close(fd);
+            is_open_ = true;
+        }
+
+        void close() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<uint8_t*>(data_), size_);
+            }
+            data_ = nullptr;
+            size_ = 0;
+            is_open_ = false;
+        }
+#elif defined(JSONCONS_HAS_WINDOWS_MMAP)
+        void open(const std::string& path) noexcept
+        {
+            file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE)
+            {
+                return;
+            }
+            LARGE_INTEGER file_size;
+            if (!::GetFileSizeEx(file_, &file_size))
+            {
+                close();
+                return;
+            }
+            size_ = static_cast<std::size_t>(file_size.QuadPart);
+            if (size_ > 0)
+            {
+                mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping_ == nullptr)
+                {
+                    close();
+                    return;
+                }
+                void* p = ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+                if (p == nullptr)
+                {
+                    close();
+                    return;
+                }
+                data_ = static_cast<const uint8_t*>(p);
+            }
+            is_open_ = true;
+        }
+
+        void close() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::UnmapViewOfFile(data_);
+            }
+            if (mapping_ != nullptr)
+            {
+                ::CloseHandle(mapping_);
+            }
+            if (file_ != INVALID_HANDLE_VALUE)
+            {
+                ::CloseHandle(file_);
+            }
+            data_ = nullptr;
+            size_ = 0;
+            is_open_ = false;
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+        }
+#endif
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif // defined(JSONCONS_HAS_MMAP)
+
+#endif
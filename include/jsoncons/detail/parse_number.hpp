@@ -16,6 +16,7 @@
 #include <type_traits> // std::enable_if
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
 #include <cctype>
 
 namespace jsoncons { namespace detail {
@@ -792,8 +793,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = _strtod_l(s, &end, locale_);
         if (s == end)
@@ -805,8 +811,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = _wcstod_l(s, &end, locale_);
         if (s == end)
@@ -852,6 +863,11 @@ public:
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
     operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), result))
+        {
+            return result;
+        }
         char *end = nullptr;
         double val = strtold_l(s, &end, locale_);
         if (s == end)
@@ -865,6 +881,11 @@ public:
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
     operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = wcstold_l(s, &end, locale_);
         if (s == end)
@@ -907,8 +928,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = strtod(s, &end);
         if (s == end)
@@ -920,8 +946,13 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double result;
+        if (decimal_to_double(s, length, static_cast<CharT>(get_decimal_point()), result))
+        {
+            return result;
+        }
         CharT *end = nullptr;
         double val = wcstod(s, &end);
         if (s == end)
@@ -0,0 +1,639 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_SCAN_HPP
+#define JSONCONS_DETAIL_SIMD_SCAN_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/unicode_traits.hpp>
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2)
+#  include <immintrin.h>
+#elif defined(JSONCONS_HAS_NEON)
+#  include <arm_neon.h>
+#endif
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    // Number of trailing zero bits, x must be non-zero
+    inline int trailing_zeros(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+    #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((x & 1) == 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // Number of set bits
+    inline int popcount(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+    #else
+        int n = 0;
+        for (; x != 0; x &= x - 1)
+        {
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // Index of the highest set bit, x must be non-zero
+    inline int highest_bit(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(x);
+    #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanReverse64(&index, x);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while (x >>= 1)
+        {
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // skip_whitespace
+
+    // Returns a pointer to the first character in [first,last) that is not a space,
+    // a horizontal tab or a line feed, or last if there is none. Adds the number of
+    // line feeds passed over to lines, and if there were any, sets line_start to 
+    // the character following the last one.
+
+    template <class CharT>
+    const CharT* skip_whitespace(const CharT* first, const CharT* last, 
+                                 std::size_t& lines, const CharT*& line_start)
+    {
+        for (; first != last; ++first)
+        {
+            switch (*first)
+            {
+                case ' ':
+                case '\t':
+                    break;
+                case '\n':
+                    ++lines;
+                    line_start = first + 1;
+                    break;
+                default:
+                    return first;
+            }
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2) || defined(JSONCONS_HAS_NEON)
+
+    inline const char* skip_whitespace(const char* first, const char* last, 
+                                       std::size_t& lines, const char*& line_start)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        const __m256i space32 = _mm256_set1_epi8(' ');
+        const __m256i tab32 = _mm256_set1_epi8('\t');
+        const __m256i lf32 = _mm256_set1_epi8('\n');
+        while (last - first >= 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i lf = _mm256_cmpeq_epi8(v, lf32);
+            __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space32),
+                                                         _mm256_cmpeq_epi8(v, tab32)), lf);
+            uint32_t stop = ~static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+            uint32_t lf_mask = static_cast<uint32_t>(_mm256_movemask_epi8(lf));
+            if (stop != 0)
+            {
+                lf_mask &= (stop & (0u - stop)) - 1;
+            }
+            if (lf_mask != 0)
+            {
+                lines += popcount(lf_mask);
+                line_start = first + highest_bit(lf_mask) + 1;
+            }
+            if (stop != 0)
+            {
+                return first + trailing_zeros(stop);
+            }
+            first += 32;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i m = _mm_cmpeq_epi8(v, lf);
+            __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space),
+                                                   _mm_cmpeq_epi8(v, tab)), m);
+            uint32_t stop = ~static_cast<uint32_t>(_mm_movemask_epi8(ws)) & 0xffff;
+            uint32_t lf_mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+            if (stop != 0)
+            {
+                lf_mask &= (stop & (0u - stop)) - 1;
+            }
+            if (lf_mask != 0)
+            {
+                lines += popcount(lf_mask);
+                line_start = first + highest_bit(lf_mask) + 1;
+            }
+            if (stop != 0)
+            {
+                return first + trailing_zeros(stop);
+            }
+            first += 16;
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        const uint8x16_t space = vdupq_n_u8(' ');
+        const uint8x16_t tab = vdupq_n_u8('\t');
+        const uint8x16_t lf = vdupq_n_u8('\n');
+        while (last - first >= 16)
+        {
+            uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+            uint8x16_t m = vceqq_u8(v, lf);
+            uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(v, space), vceqq_u8(v, tab)), m);
+            // Four bits per character
+            uint64_t stop = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(ws), 4)), 0);
+            uint64_t lf_mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+            if (stop != 0)
+            {
+                lf_mask &= (stop & (0 - stop)) - 1;
+            }
+            if (lf_mask != 0)
+            {
+                lines += popcount(lf_mask) >> 2;
+                line_start = first + (highest_bit(lf_mask) >> 2) + 1;
+            }
+            if (stop != 0)
+            {
+                return first + (trailing_zeros(stop) >> 2);
+            }
+            first += 16;
+        }
+    #endif
+        return skip_whitespace<char>(first, last, lines, line_start);
+    }
+
+#endif
+
+    // find_string_special
+
+    // Returns a pointer to the first character in [first,last) that ends a run of
+    // plain string content: a quotation mark, a reverse solidus or a control character
+    // (less than 0x20.) Returns last if there is no such character. Sets non_ascii
+    // to true if the run contains a character greater than 0x7f, otherwise leaves 
+    // it unchanged.
+
+    template <class CharT>
+    const CharT* find_string_special(const CharT* first, const CharT* last, bool& non_ascii)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        uchar_type bits = 0;
+        for (; first != last; ++first)
+        {
+            uchar_type c = static_cast<uchar_type>(*first);
+            if (c == '\"' || c == '\\' || c < 0x20)
+            {
+                break;
+            }
+            bits |= c;
+        }
+        if (bits >= 0x80)
+        {
+            non_ascii = true;
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2) || defined(JSONCONS_HAS_NEON)
+
+    inline const char* find_string_special(const char* first, const char* last, bool& non_ascii)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        const __m256i quote32 = _mm256_set1_epi8('\"');
+        const __m256i backslash32 = _mm256_set1_epi8('\\');
+        const __m256i ctrl32 = _mm256_set1_epi8(0x1f);
+        while (last - first >= 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote32),
+                                                        _mm256_cmpeq_epi8(v, backslash32)),
+                                        _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl32), v));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+            uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+            if (mask != 0)
+            {
+                // Only characters before the special one belong to the run
+                if ((high & ((mask & (0u - mask)) - 1)) != 0)
+                {
+                    non_ascii = true;
+                }
+                return first + trailing_zeros(mask);
+            }
+            if (high != 0)
+            {
+                non_ascii = true;
+            }
+            first += 32;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i ctrl = _mm_set1_epi8(0x1f);
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                                  _mm_cmpeq_epi8(v, backslash)),
+                                     _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl), v));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+            uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(v));
+            if (mask != 0)
+            {
+                if ((high & ((mask & (0u - mask)) - 1)) != 0)
+                {
+                    non_ascii = true;
+                }
+                return first + trailing_zeros(mask);
+            }
+            if (high != 0)
+            {
+                non_ascii = true;
+            }
+            first += 16;
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        const uint8x16_t quote = vdupq_n_u8('\"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        const uint8x16_t ctrl = vdupq_n_u8(0x1f);
+        const uint8x16_t high_bit = vdupq_n_u8(0x80);
+        while (last - first >= 16)
+        {
+            uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+            uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+                                    vcleq_u8(v, ctrl));
+            // Narrow each byte of the comparison results to a nibble
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+            uint64_t high = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vtstq_u8(v, high_bit)), 4)), 0);
+            if (mask != 0)
+            {
+                if ((high & ((mask & (0 - mask)) - 1)) != 0)
+                {
+                    non_ascii = true;
+                }
+                return first + (trailing_zeros(mask) >> 2);
+            }
+            if (high != 0)
+            {
+                non_ascii = true;
+            }
+            first += 16;
+        }
+    #endif
+        return find_string_special<char>(first, last, non_ascii);
+    }
+
+#endif
+
+    // skip_ascii
+
+    // Returns a pointer to the first character in [first,last) that is greater than 0x7f,
+    // or last if there is none.
+
+    template <class CharT>
+    const CharT* skip_ascii(const CharT* first, const CharT* last)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        while (first != last && static_cast<uchar_type>(*first) < 0x80)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2) || defined(JSONCONS_HAS_NEON)
+
+    inline const char* skip_ascii(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        while (last - first >= 32)
+        {
+            uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first))));
+            if (high != 0)
+            {
+                return first + trailing_zeros(high);
+            }
+            first += 32;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        while (last - first >= 16)
+        {
+            uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))));
+            if (high != 0)
+            {
+                return first + trailing_zeros(high);
+            }
+            first += 16;
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        const uint8x16_t high_bit = vdupq_n_u8(0x80);
+        while (last - first >= 16)
+        {
+            uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+            uint64_t high = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vtstq_u8(v, high_bit)), 4)), 0);
+            if (high != 0)
+            {
+                return first + (trailing_zeros(high) >> 2);
+            }
+            first += 16;
+        }
+    #endif
+        return skip_ascii<char>(first, last);
+    }
+
+#endif
+
+    // validate_utf
+
+    // Same result as unicons::validate. For UTF-8, runs of ASCII characters are 
+    // skipped a block at a time, and only multi-byte sequences are checked one by one.
+
+    template <class CharT>
+    unicons::convert_result<const CharT*> validate_utf(const CharT* first, const CharT* last)
+    {
+        return unicons::validate(first, last);
+    }
+
+    inline unicons::convert_result<const char*> validate_utf(const char* first, const char* last)
+    {
+        unicons::conv_errc result = unicons::conv_errc();
+        while (first != last)
+        {
+            first = skip_ascii(first, last);
+            if (first == last)
+            {
+                break;
+            }
+            std::size_t length = static_cast<std::size_t>(unicons::trailing_bytes_for_utf8[static_cast<uint8_t>(*first)]) + 1;
+            if (length > static_cast<std::size_t>(last - first))
+            {
+                return unicons::convert_result<const char*>{first, unicons::conv_errc::source_exhausted};
+            }
+            if ((result=unicons::is_legal_utf8(first, length)) != unicons::conv_errc())
+            {
+                return unicons::convert_result<const char*>{first,result};
+            }
+            first += length;
+        }
+        return unicons::convert_result<const char*>{first,result};
+    }
+
+    // build_structural_index
+
+    // Bit masks of the characters of interest in a block of up to 64 characters,
+    // bit i corresponds to character i
+    struct structural_masks
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;          // { } [ ] : ,
+        uint64_t whitespace;  // space, horizontal tab, line feed, carriage return
+        uint64_t slash;
+    };
+
+    template <class CharT>
+    void classify_block(const CharT* p, std::size_t n, structural_masks& masks)
+    {
+        masks = structural_masks();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const uint64_t bit = uint64_t(1) << i;
+            switch (p[i])
+            {
+                case '\"':
+                    masks.quote |= bit;
+                    break;
+                case '\\':
+                    masks.backslash |= bit;
+                    break;
+                case '{': case '}': case '[': case ']': case ':': case ',':
+                    masks.op |= bit;
+                    break;
+                case ' ': case '\t': case '\n': case '\r':
+                    masks.whitespace |= bit;
+                    break;
+                case '/':
+                    masks.slash |= bit;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2) || defined(JSONCONS_HAS_NEON)
+
+#if defined(JSONCONS_HAS_NEON) && !defined(JSONCONS_HAS_SSE2)
+    // One bit per character, like _mm_movemask_epi8
+    inline uint64_t movemask(uint8x16_t v)
+    {
+        static const uint8_t weights[16] = {1,2,4,8,16,32,64,128,1,2,4,8,16,32,64,128};
+        uint8x16_t masked = vandq_u8(vld1q_u8(weights), v);
+        uint8x8_t sum = vpadd_u8(vget_low_u8(masked), vget_high_u8(masked));
+        sum = vpadd_u8(sum, sum);
+        sum = vpadd_u8(sum, sum);
+        return vget_lane_u16(vreinterpret_u16_u8(sum), 0);
+    }
+#endif
+
+    // Classifies a full block of 64 characters
+    inline void classify_block(const char* p, structural_masks& masks)
+    {
+        masks = structural_masks();
+    #if defined(JSONCONS_HAS_AVX2)
+        for (int i = 0; i < 2; ++i)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32*i));
+            // '[' and ']' differ from '{' and '}' only in bit 0x20
+            __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+            __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')),
+                                                         _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')),
+                                                         _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+            __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                         _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                                         _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+            const int shift = 32*i;
+            masks.quote |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"'))))) << shift;
+            masks.backslash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))))) << shift;
+            masks.op |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << shift;
+            masks.whitespace |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(ws))) << shift;
+            masks.slash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'))))) << shift;
+        }
+    #elif defined(JSONCONS_HAS_SSE2)
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16*i));
+            __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')),
+                                                   _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')),
+                                                   _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+            __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+            const int shift = 16*i;
+            masks.quote |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"'))))) << shift;
+            masks.backslash |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))) << shift;
+            masks.op |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(op))) << shift;
+            masks.whitespace |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(ws))) << shift;
+            masks.slash |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('/'))))) << shift;
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        for (int i = 0; i < 4; ++i)
+        {
+            uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p + 16*i));
+            uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+            uint8x16_t op = vorrq_u8(vorrq_u8(vceqq_u8(lower, vdupq_n_u8('{')), vceqq_u8(lower, vdupq_n_u8('}'))),
+                                     vorrq_u8(vceqq_u8(v, vdupq_n_u8(':')), vceqq_u8(v, vdupq_n_u8(','))));
+            uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))),
+                                     vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+            const int shift = 16*i;
+            masks.quote |= movemask(vceqq_u8(v, vdupq_n_u8('\"'))) << shift;
+            masks.backslash |= movemask(vceqq_u8(v, vdupq_n_u8('\\'))) << shift;
+            masks.op |= movemask(op) << shift;
+            masks.whitespace |= movemask(ws) << shift;
+            masks.slash |= movemask(vceqq_u8(v, vdupq_n_u8('/'))) << shift;
+        }
+    #endif
+    }
+
+#endif
+
+    // Bit i of the result is the exclusive or of bits 0 through i of x
+    inline uint64_t prefix_xor(uint64_t x)
+    {
+        x ^= x << 1;
+        x ^= x << 2;
+        x ^= x << 4;
+        x ^= x << 8;
+        x ^= x << 16;
+        x ^= x << 32;
+        return x;
+    }
+
+    template <class CharT>
+    void classify_full_block(const CharT* p, structural_masks& masks)
+    {
+        classify_block(p, 64, masks);
+    }
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2) || defined(JSONCONS_HAS_NEON)
+    inline void classify_full_block(const char* p, structural_masks& masks)
+    {
+        classify_block(p, masks);
+    }
+#endif
+
+    // Appends to index the offsets of the structural characters { } [ ] : , that 
+    // lie outside strings, of the quotation marks that open strings, and of the first 
+    // character of every other token (numbers, literals and anything unexpected.)
+    // Returns false, leaving the index incomplete, if a solidus appears outside a 
+    // string, as comments cannot be indexed this way.
+
+    template <class CharT, class Index>
+    bool build_structural_index(const CharT* data, std::size_t length, Index& index)
+    {
+        uint64_t prev_escaped = 0;    // 1 if the first character of the next block is escaped
+        uint64_t prev_in_string = 0;  // all ones if the next block starts inside a string
+        uint64_t prev_scalar = 0;     // 1 if the last character of the previous block is part of a token
+
+        for (std::size_t offset = 0; offset < length; offset += 64)
+        {
+            structural_masks masks;
+            uint64_t valid;
+            if (length - offset >= 64)
+            {
+                classify_full_block(data + offset, masks);
+                valid = ~uint64_t(0);
+            }
+            else
+            {
+                classify_block(data + offset, length - offset, masks);
+                valid = (uint64_t(1) << (length - offset)) - 1;
+            }
+
+            // A backslash that is not itself escaped escapes the next character
+            uint64_t escaped = prev_escaped;
+            uint64_t backslash = masks.backslash & ~prev_escaped;
+            prev_escaped = 0;
+            while (backslash != 0)
+            {
+                int i = trailing_zeros(backslash);
+                if (i == 63)
+                {
+                    prev_escaped = 1;
+                    break;
+                }
+                escaped |= uint64_t(1) << (i + 1);
+                backslash &= ~(uint64_t(3) << i);
+            }
+
+            const uint64_t quote = masks.quote & ~escaped;
+            // Set from an opening quotation mark up to, not including, the closing one
+            const uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+            prev_in_string = 0 - (in_string >> 63);
+
+            if ((masks.slash & ~in_string & valid) != 0)
+            {
+                return false;
+            }
+
+            const uint64_t scalar = ~(masks.op | masks.whitespace | masks.quote | in_string);
+            const uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+            prev_scalar = scalar >> 63;
+
+            uint64_t structurals = ((masks.op & ~in_string) | (quote & in_string) | scalar_start) & valid;
+            while (structurals != 0)
+            {
+                index.push_back(static_cast<typename Index::value_type>(offset + trailing_zeros(structurals)));
+                structurals &= structurals - 1;
+            }
+        }
+        return true;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,142 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_WORKER_POOL_HPP
+#define JSONCONS_DETAIL_WORKER_POOL_HPP
+
+#include <cstddef>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jsoncons {
+namespace detail {
+
+    // worker_pool
+
+    // Worker threads that are started when first needed and kept until the pool is
+    // destroyed, so that a reader that parses many batches does not start and join
+    // threads for each one. run() hands out the tasks of one batch to the calling
+    // thread and the workers, and returns when all of them have finished.
+    class worker_pool
+    {
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable start_cv_;
+        std::condition_variable done_cv_;
+        std::function<void(std::size_t)> job_;
+        std::size_t task_count_;
+        std::size_t next_task_;
+        std::size_t unfinished_;
+        std::size_t batch_;
+        bool stop_;
+
+        // Noncopyable and nonmoveable
+        worker_pool(const worker_pool&) = delete;
+        worker_pool& operator=(const worker_pool&) = delete;
+    public:
+        worker_pool()
+            : task_count_(0), next_task_(0), unfinished_(0), batch_(0), stop_(false)
+        {
+        }
+
+        ~worker_pool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            start_cv_.notify_all();
+            for (auto& t : workers_)
+            {
+                t.join();
+            }
+        }
+
+        std::size_t worker_count() const
+        {
+            return workers_.size();
+        }
+
+        // Calls job(i) for each i in [0,count), with up to count calls at a time.
+        // job must not throw.
+        void run(std::size_t count, std::function<void(std::size_t)> job)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            while (workers_.size() + 1 < count)
+            {
+                workers_.emplace_back([this]() {work_loop();});
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job_ = std::move(job);
+                task_count_ = count;
+                next_task_ = 0;
+                unfinished_ = count;
+                ++batch_;
+            }
+            start_cv_.notify_all();
+            work();
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_cv_.wait(lock, [this]() {return unfinished_ == 0;});
+        }
+
+    private:
+        // Takes tasks from the current batch until none are left
+        void work()
+        {
+            for (;;)
+            {
+                std::size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (next_task_ == task_count_)
+                    {
+                        return;
+                    }
+                    i = next_task_++;
+                }
+                // job_ does not change until every task of the batch has finished
+                job_(i);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (--unfinished_ == 0)
+                    {
+                        done_cv_.notify_one();
+                    }
+                }
+            }
+        }
+
+        void work_loop()
+        {
+            std::size_t batch = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_cv_.wait(lock, [&]() {return stop_ || batch_ != batch;});
+                    if (stop_)
+                    {
+                        return;
+                    }
+                    batch = batch_;
+                }
+                work();
+            }
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,441 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ARRAY_READER_HPP
+#define JSONCONS_JSON_ARRAY_READER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <thread>
+#include <limits> // std::numeric_limits
+#include <exception> // std::exception_ptr
+#include <system_error>
+#include <utility> // std::move
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/convert_error.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+#include <jsoncons/detail/worker_pool.hpp>
+
+namespace jsoncons {
+
+// basic_json_array_reader parses an in-memory text that holds one large top level
+// array. A quick scan that tracks strings and nesting finds where the elements of
+// the top level array start and end, then the elements are parsed concurrently,
+// one basic_json_parser and json_decoder per thread, in batches of at most
+// thread_count*chunk_size characters. The worker threads are started for the first
+// batch and kept until the reader is destroyed. The reader holds a view of the text,
+// which must outlive it.
+//
+// The result is the same as parsing serially. A text that the scan cannot split
+// (a root that is not an array, comments, or anything malformed outside the elements),
+// a text longer than max_input_length, and a text with an error in an element are
+// parsed serially, so errors are reported with the same code, line and column as
+// basic_json_reader.
+
+template <class CharT,class TempAllocator=std::allocator<char>>
+class basic_json_array_reader : public ser_context
+{
+public:
+    using char_type = CharT;
+    using string_view_type = jsoncons::basic_string_view<CharT>;
+
+    static constexpr std::size_t default_chunk_size = 1024*1024;
+private:
+    using parser_type = basic_json_parser<CharT,TempAllocator>;
+
+    struct element
+    {
+        const CharT* first;
+        const CharT* last;
+
+        element(const CharT* begin, const CharT* end)
+            : first(begin), last(end)
+        {
+        }
+    };
+
+    struct task
+    {
+        std::size_t first;
+        std::size_t last;
+        std::error_code ec;
+        std::exception_ptr exception;
+
+        task(std::size_t begin, std::size_t end)
+            : first(begin), last(end)
+        {
+        }
+    };
+
+    string_view_type text_;
+    basic_json_decode_options<CharT> options_;
+    std::size_t thread_count_;
+    std::size_t chunk_size_;
+    TempAllocator alloc_;
+    std::size_t line_;
+    std::size_t column_;
+    jsoncons::detail::worker_pool workers_;
+
+    // Noncopyable and nonmoveable
+    basic_json_array_reader(const basic_json_array_reader&) = delete;
+    basic_json_array_reader& operator=(const basic_json_array_reader&) = delete;
+public:
+    // A thread_count of 0 means std::thread::hardware_concurrency()
+    basic_json_array_reader(const string_view_type& text,
+                            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                            std::size_t thread_count = 0,
+                            std::size_t chunk_size = default_chunk_size,
+                            const TempAllocator& alloc = TempAllocator())
+        : text_(text), options_(options),
+          thread_count_(resolve_thread_count(thread_count)),
+          chunk_size_(chunk_size > 0 ? chunk_size : 1),
+          alloc_(alloc), line_(0), column_(0)
+    {
+    }
+
+    std::size_t thread_count() const
+    {
+        return thread_count_;
+    }
+
+    // Parses the text into a Json value, a top level array is reserved up front
+    template <class Json>
+    Json read()
+    {
+        std::error_code ec;
+        Json result = read<Json>(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+        return result;
+    }
+
+    template <class Json>
+    Json read(std::error_code& ec)
+    {
+        std::vector<element> elements;
+        if (!find_elements(elements))
+        {
+            return read_serially<Json>(ec);
+        }
+        Json result(json_array_arg, semantic_tag::none);
+        result.reserve(elements.size());
+        if (!read_batches<Json>(elements, [&](Json&& val) {result.push_back(std::move(val));}))
+        {
+            return read_serially<Json>(ec);
+        }
+        return result;
+    }
+
+    // Parses the elements of a top level array and passes them to f, in order.
+    // f is only called for elements that precede an error. A root that is not an
+    // array is reported as convert_errc::not_vector.
+    template <class Json,class F>
+    void read_elements(F f)
+    {
+        std::error_code ec;
+        read_elements<Json>(f, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+    }
+
+    template <class Json,class F>
+    void read_elements(F f, std::error_code& ec)
+    {
+        std::vector<element> elements;
+        if (find_elements(elements))
+        {
+            if (!read_batches<Json>(elements, f))
+            {
+                find_error(ec);
+            }
+            return;
+        }
+        Json result = read_serially<Json>(ec);
+        if (ec)
+        {
+            return;
+        }
+        if (!result.is_array())
+        {
+            ec = convert_errc::not_vector;
+            return;
+        }
+        for (auto& val : result.array_range())
+        {
+            f(std::move(val));
+        }
+    }
+
+    // The line and column of the error, if any
+    std::size_t line() const override
+    {
+        return line_;
+    }
+
+    std::size_t column() const override
+    {
+        return column_;
+    }
+
+private:
+    static std::size_t resolve_thread_count(std::size_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        return thread_count > 0 ? thread_count : 1;
+    }
+
+    static bool is_whitespace(CharT c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool is_blank(const CharT* first, const CharT* last)
+    {
+        for (; first != last; ++first)
+        {
+            if (!is_whitespace(*first))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Finds the elements of a top level array. Returns false if the text is not
+    // a top level array with well formed separators, or has a comment.
+    bool find_elements(std::vector<element>& elements) const
+    {
+        // Each element is parsed one level down, and the input limit applies to
+        // the whole text
+        if (options_.max_nesting_depth() < 1 || text_.size() > options_.max_input_length())
+        {
+            return false;
+        }
+
+        const CharT* p = text_.data();
+        const CharT* end = text_.data() + text_.size();
+        while (p != end && is_whitespace(*p))
+        {
+            ++p;
+        }
+        if (p == end || *p != '[')
+        {
+            return false;
+        }
+        ++p;
+
+        const CharT* element_start = p;
+        std::size_t depth = 1;
+        while (depth > 0)
+        {
+            if (p == end)
+            {
+                return false;
+            }
+            switch (*p)
+            {
+                case '\"':
+                {
+                    ++p;
+                    bool non_ascii = false;
+                    for (;;)
+                    {
+                        p = jsoncons::detail::find_string_special(p, end, non_ascii);
+                        if (p == end)
+                        {
+                            return false;
+                        }
+                        if (*p == '\"')
+                        {
+                            break;
+                        }
+                        // Skip an escaped character, a control character is an error
+                        // for the parser to report
+                        p += (*p == '\\' && p + 1 != end) ? 2 : 1;
+                    }
+                    break;
+                }
+                case '[':
+                case '{':
+                    ++depth;
+                    break;
+                case '}':
+                    if (depth == 1)
+                    {
+                        return false;
+                    }
+                    --depth;
+                    break;
+                case ']':
+                    if (--depth == 0)
+                    {
+                        if (is_blank(element_start, p))
+                        {
+                            if (!elements.empty())
+                            {
+                                return false;
+                            }
+                        }
+                        else
+                        {
+                            elements.emplace_back(element_start, p);
+                        }
+                    }
+                    break;
+                case ',':
+                    if (depth == 1)
+                    {
+                        if (is_blank(element_start, p))
+                        {
+                            return false;
+                        }
+                        elements.emplace_back(element_start, p);
+                        element_start = p + 1;
+                    }
+                    break;
+                case '/':
+                    return false;
+                default:
+                    break;
+            }
+            ++p;
+        }
+        return is_blank(p, end);
+    }
+
+    // Parses the elements in batches and passes them to f in order. Returns false
+    // if an element has an error.
+    template <class Json,class F>
+    bool read_batches(const std::vector<element>& elements, F f)
+    {
+        basic_json_options<CharT> element_options;
+        static_cast<basic_json_decode_options<CharT>&>(element_options) = options_;
+        element_options.max_nesting_depth(options_.max_nesting_depth() - 1);
+        element_options.max_input_length((std::numeric_limits<std::size_t>::max)());
+
+        const std::size_t batch_size = thread_count_ * chunk_size_;
+        std::vector<std::vector<Json>> values(thread_count_);
+        std::vector<task> tasks;
+
+        std::size_t next = 0;
+        while (next < elements.size())
+        {
+            // Split the next batch into tasks of about chunk_size characters
+            tasks.clear();
+            std::size_t batch_length = 0;
+            while (tasks.size() < thread_count_ && next < elements.size() && batch_length < batch_size)
+            {
+                std::size_t first = next;
+                std::size_t length = 0;
+                while (next < elements.size() && (next == first || length < chunk_size_))
+                {
+                    length += elements[next].last - elements[next].first;
+                    ++next;
+                }
+                tasks.emplace_back(first, next);
+                batch_length += length;
+            }
+
+            auto parse = [&](std::size_t i)
+            {
+                JSONCONS_TRY
+                {
+                    values[i].clear();
+                    values[i].reserve(tasks[i].last - tasks[i].first);
+                    parser_type parser(element_options, alloc_);
+                    json_decoder<Json,TempAllocator> decoder(alloc_);
+                    for (std::size_t j = tasks[i].first; j < tasks[i].last; ++j)
+                    {
+                        parser.reset();
+                        parser.update(elements[j].first, elements[j].last - elements[j].first);
+                        parser.finish_parse(decoder, tasks[i].ec);
+                        if (!tasks[i].ec)
+                        {
+                            parser.check_done(tasks[i].ec);
+                        }
+                        if (tasks[i].ec)
+                        {
+                            return;
+                        }
+                        values[i].push_back(decoder.get_result());
+                    }
+                }
+                JSONCONS_CATCH(...)
+                {
+                    tasks[i].exception = std::current_exception();
+                }
+            };
+
+            workers_.run(tasks.size(), parse);
+
+            for (std::size_t i = 0; i < tasks.size(); ++i)
+            {
+                if (tasks[i].exception)
+                {
+                    std::rethrow_exception(tasks[i].exception);
+                }
+                for (auto& val : values[i])
+                {
+                    f(std::move(val));
+                }
+                if (tasks[i].ec)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <class Json>
+    Json read_serially(std::error_code& ec)
+    {
+        json_decoder<Json,TempAllocator> decoder(alloc_);
+        parse_serially(decoder, ec);
+        return ec ? Json() : decoder.get_result();
+    }
+
+    void find_error(std::error_code& ec)
+    {
+        basic_default_json_visitor<CharT> visitor;
+        parse_serially(visitor, ec);
+    }
+
+    void parse_serially(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        parser_type parser(options_, alloc_);
+        parser.update(text_.data(), text_.size());
+        parser.finish_parse(visitor, ec);
+        if (!ec)
+        {
+            parser.check_done(ec);
+        }
+        if (ec)
+        {
+            line_ = parser.line();
+            column_ = parser.column();
+        }
+    }
+};
+
+using json_array_reader = basic_json_array_reader<char>;
+using wjson_array_reader = basic_json_array_reader<wchar_t>;
+
+}
+
+#endif
+
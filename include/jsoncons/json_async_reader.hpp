@@ -0,0 +1,474 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ASYNC_READER_HPP
+#define JSONCONS_JSON_ASYNC_READER_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_COROUTINES)
+
+#include <coroutine>
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <memory> // std::allocator
+#include <optional>
+#include <system_error>
+#include <utility> // std::move, std::exchange
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/unicode_traits.hpp>
+
+namespace jsoncons {
+
+// C++20 coroutine front ends to basic_json_parser, for parsing many texts
+// concurrently on an event loop, without a thread per text.
+//
+// The text comes from an asynchronous source. An asynchronous source has a member
+// function read_buffer() that returns an awaitable, and co_await on that awaitable
+// produces the next buffer of the text, a span-like object with data() and size().
+// An empty buffer means the end of the text. A buffer must stay valid until the
+// next call to read_buffer(). Strings, numbers and literals may span buffers.
+//
+// The source and the visitor are held by reference and must outlive the reader.
+
+// async_task
+
+// A lazily started coroutine that produces a T. Another coroutine runs it with
+// co_await, which resumes the awaiting coroutine when the task completes and
+// returns its result or rethrows its exception. A task that is not awaited can be
+// started with start(), and its result taken with get() once done() is true.
+template <class T>
+class async_task;
+
+namespace detail {
+
+    // Resumes the coroutine that awaited the task, if any
+    struct async_task_final_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+        {
+            std::coroutine_handle<> continuation = h.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    struct async_task_promise_base
+    {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        async_task_final_awaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            exception = std::current_exception();
+        }
+
+        void rethrow_if_exception() const
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+
+    template <class T>
+    struct async_task_promise : async_task_promise_base
+    {
+        std::optional<T> value;
+
+        async_task<T> get_return_object() noexcept;
+
+        template <class U>
+        void return_value(U&& val)
+        {
+            value.emplace(std::forward<U>(val));
+        }
+
+        T result()
+        {
+            rethrow_if_exception();
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct async_task_promise<void> : async_task_promise_base
+    {
+        async_task<void> get_return_object() noexcept;
+
+        void return_void() noexcept
+        {
+        }
+
+        void result() const
+        {
+            rethrow_if_exception();
+        }
+    };
+
+} // namespace detail
+
+template <class T>
+class async_task
+{
+public:
+    using promise_type = detail::async_task_promise<T>;
+private:
+    std::coroutine_handle<promise_type> handle_;
+public:
+    async_task() noexcept
+        : handle_(nullptr)
+    {
+    }
+
+    explicit async_task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    async_task(async_task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    async_task(const async_task&) = delete;
+    async_task& operator=(const async_task&) = delete;
+
+    async_task& operator=(async_task&& other) noexcept
+    {
+        std::swap(handle_, other.handle_);
+        return *this;
+    }
+
+    ~async_task() noexcept
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    // Runs the task until it completes or first suspends
+    void start()
+    {
+        if (handle_ && !handle_.done())
+        {
+            handle_.resume();
+        }
+    }
+
+    bool done() const noexcept
+    {
+        return !handle_ || handle_.done();
+    }
+
+    // The result of a completed task, rethrows the exception that ended it
+    T get()
+    {
+        return handle_.promise().result();
+    }
+
+    bool await_ready() const noexcept
+    {
+        return !handle_ || handle_.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume()
+    {
+        return handle_.promise().result();
+    }
+};
+
+namespace detail {
+
+    template <class T>
+    async_task<T> async_task_promise<T>::get_return_object() noexcept
+    {
+        return async_task<T>(std::coroutine_handle<async_task_promise<T>>::from_promise(*this));
+    }
+
+    inline
+    async_task<void> async_task_promise<void>::get_return_object() noexcept
+    {
+        return async_task<void>(std::coroutine_handle<async_task_promise<void>>::from_promise(*this));
+    }
+
+} // namespace detail
+
+// basic_json_async_reader
+
+// Parses one JSON text from an asynchronous source and pushes it to a visitor,
+// like basic_json_reader.
+template <class CharT,class AsyncSource,class Allocator=std::allocator<char>>
+class basic_json_async_reader : private ser_context
+{
+public:
+    using char_type = CharT;
+    using source_type = AsyncSource;
+    using temp_allocator_type = Allocator;
+private:
+    source_type& source_;
+    basic_json_visitor<CharT>& visitor_;
+    basic_json_parser<CharT,Allocator> parser_;
+    bool eof_;
+    bool begin_;
+
+    // Noncopyable and nonmoveable
+    basic_json_async_reader(const basic_json_async_reader&) = delete;
+    basic_json_async_reader& operator=(const basic_json_async_reader&) = delete;
+public:
+    basic_json_async_reader(source_type& source,
+                            basic_json_visitor<CharT>& visitor,
+                            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                            std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
+                            const Allocator& alloc = Allocator())
+       : source_(source),
+         visitor_(visitor),
+         parser_(options,err_handler,alloc),
+         eof_(false),
+         begin_(true)
+    {
+    }
+
+    // Parses the text, the task throws ser_error on a parse error
+    async_task<void> read()
+    {
+        std::error_code ec;
+        co_await read(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    // Parses the text, ec must outlive the task
+    async_task<void> read(std::error_code& ec)
+    {
+        while (!parser_.finished())
+        {
+            if (parser_.source_exhausted() && !eof_)
+            {
+                auto buffer = co_await source_.read_buffer();
+                update_parser(buffer.data(), buffer.size(), ec);
+                if (ec) co_return;
+            }
+            parser_.parse_some(visitor_, ec);
+            if (ec) co_return;
+        }
+        while (!eof_)
+        {
+            if (parser_.source_exhausted())
+            {
+                auto buffer = co_await source_.read_buffer();
+                update_parser(buffer.data(), buffer.size(), ec);
+                if (ec) co_return;
+            }
+            if (!eof_)
+            {
+                parser_.check_done(ec);
+                if (ec) co_return;
+            }
+        }
+    }
+
+    bool eof() const
+    {
+        return eof_;
+    }
+
+    std::size_t line() const override
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const override
+    {
+        return parser_.column();
+    }
+
+private:
+    void update_parser(const CharT* data, std::size_t length, std::error_code& ec)
+    {
+        if (length == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(data, data+length);
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - data;
+            parser_.update(data+offset,length-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(data,length);
+        }
+    }
+};
+
+// basic_json_async_cursor
+
+// Pulls the events of one JSON text from an asynchronous source, like
+// basic_json_cursor. Unlike basic_json_cursor, the constructor does not read,
+// the first co_await next() moves to the first event.
+template <class CharT,class AsyncSource,class Allocator=std::allocator<char>>
+class basic_json_async_cursor : private ser_context
+{
+public:
+    using char_type = CharT;
+    using source_type = AsyncSource;
+    using temp_allocator_type = Allocator;
+private:
+    source_type& source_;
+    basic_json_parser<CharT,Allocator> parser_;
+    basic_staj_visitor<CharT> cursor_visitor_;
+    bool eof_;
+    bool begin_;
+
+    // Noncopyable and nonmoveable
+    basic_json_async_cursor(const basic_json_async_cursor&) = delete;
+    basic_json_async_cursor& operator=(const basic_json_async_cursor&) = delete;
+public:
+    basic_json_async_cursor(source_type& source,
+                            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                            std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
+                            const Allocator& alloc = Allocator())
+       : source_(source),
+         parser_(options,err_handler,alloc),
+         eof_(false),
+         begin_(true)
+    {
+    }
+
+    bool done() const
+    {
+        return parser_.done();
+    }
+
+    const basic_staj_event<CharT>& current() const
+    {
+        return cursor_visitor_.event();
+    }
+
+    // Moves to the next event, the task throws ser_error on a parse error
+    async_task<void> next()
+    {
+        std::error_code ec;
+        co_await next(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    // Moves to the next event, ec must outlive the task
+    async_task<void> next(std::error_code& ec)
+    {
+        parser_.restart();
+        while (!parser_.stopped())
+        {
+            if (parser_.source_exhausted() && !eof_)
+            {
+                auto buffer = co_await source_.read_buffer();
+                update_parser(buffer.data(), buffer.size(), ec);
+                if (ec) co_return;
+            }
+            parser_.parse_some(cursor_visitor_, ec);
+            if (ec) co_return;
+        }
+    }
+
+    const ser_context& context() const
+    {
+        return *this;
+    }
+
+    std::size_t line() const override
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const override
+    {
+        return parser_.column();
+    }
+
+private:
+    void update_parser(const CharT* data, std::size_t length, std::error_code& ec)
+    {
+        if (length == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(data, data+length);
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - data;
+            parser_.update(data+offset,length-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(data,length);
+        }
+    }
+};
+
+template <class AsyncSource>
+using json_async_reader = basic_json_async_reader<char,AsyncSource>;
+template <class AsyncSource>
+using wjson_async_reader = basic_json_async_reader<wchar_t,AsyncSource>;
+
+template <class AsyncSource>
+using json_async_cursor = basic_json_async_cursor<char,AsyncSource>;
+template <class AsyncSource>
+using wjson_async_cursor = basic_json_async_cursor<wchar_t,AsyncSource>;
+
+} // namespace jsoncons
+
+#endif // defined(JSONCONS_HAS_COROUTINES)
+
+#endif
@@ -21,6 +21,7 @@
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/detail/hash_index.hpp>
 
 namespace jsoncons {
 
@@ -98,6 +99,42 @@ namespace jsoncons {
         {
         }
 
+        // Uses-allocator construction, see basic_json
+        json_array(std::allocator_arg_t, const allocator_type& alloc, const json_array& val)
+            : json_array(val, alloc)
+        {
+        }
+
+        json_array(std::allocator_arg_t, const allocator_type& alloc, json_array& val)
+            : json_array(val, alloc)
+        {
+        }
+
+        json_array(std::allocator_arg_t, const allocator_type& alloc, json_array&& val)
+            : json_array(std::move(val), alloc)
+        {
+        }
+
+        template <class... Args>
+        json_array(std::allocator_arg_t, const allocator_type& alloc, Args&&... args)
+            : json_array(construct_with_allocator(typename std::is_constructible<json_array,Args&&...,const allocator_type&>::type(),
+                                                  alloc, std::forward<Args>(args)...))
+        {
+        }
+
+        // The arguments are passed on with the allocator when json_array can be constructed from them that way
+        template <class... Args>
+        static json_array construct_with_allocator(std::true_type, const allocator_type& alloc, Args&&... args)
+        {
+            return json_array(std::forward<Args>(args)..., alloc);
+        }
+
+        template <class... Args>
+        static json_array construct_with_allocator(std::false_type, const allocator_type&, Args&&... args)
+        {
+            return json_array(std::forward<Args>(args)...);
+        }
+
         json_array(const std::initializer_list<Json>& init, 
                    const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
@@ -386,6 +423,41 @@ namespace jsoncons {
         {
         }
 
+        // Uses-allocator construction, see basic_json
+        key_value(std::allocator_arg_t, const allocator_type& alloc, const key_value& member)
+            : key_(member.key_, alloc), value_(member.value_, alloc)
+        {
+        }
+
+        key_value(std::allocator_arg_t, const allocator_type& alloc, key_value& member)
+            : key_(member.key_, alloc), value_(member.value_, alloc)
+        {
+        }
+
+        key_value(std::allocator_arg_t, const allocator_type& alloc, key_value&& member)
+            : key_(std::move(member.key_), alloc), value_(std::move(member.value_), alloc)
+        {
+        }
+
+        // A name followed by the arguments for the value, as passed by emplace and try_emplace
+        template <class... Args>
+        key_value(std::allocator_arg_t, const allocator_type& alloc, const key_type& name, Args&&... args)
+            : key_(name, alloc), value_(std::allocator_arg, alloc, std::forward<Args>(args)...)
+        {
+        }
+
+        template <class... Args>
+        key_value(std::allocator_arg_t, const allocator_type& alloc, key_type&& name, Args&&... args)
+            : key_(std::move(name), alloc), value_(std::allocator_arg, alloc, std::forward<Args>(args)...)
+        {
+        }
+
+        template <class... Args>
+        key_value(std::allocator_arg_t, const allocator_type&, Args&&... args)
+            : key_value(std::forward<Args>(args)...)
+        {
+        }
+
         const key_type& key() const
         {
             return key_;
@@ -522,6 +594,11 @@ namespace jsoncons {
         explicit preserve_key_order() = default; 
     };
 
+    struct hash_key_order
+    {
+        explicit hash_key_order() = default; 
+    };
+
     template <class KeyT,class Json,class Enable = void>
     class json_object
     {
@@ -584,6 +661,42 @@ namespace jsoncons {
         {
         }
 
+        // Uses-allocator construction, see basic_json
+        json_object(std::allocator_arg_t, const allocator_type& alloc, const json_object& val)
+            : json_object(val, alloc)
+        {
+        }
+
+        json_object(std::allocator_arg_t, const allocator_type& alloc, json_object& val)
+            : json_object(val, alloc)
+        {
+        }
+
+        json_object(std::allocator_arg_t, const allocator_type& alloc, json_object&& val)
+            : json_object(std::move(val), alloc)
+        {
+        }
+
+        template <class... Args>
+        json_object(std::allocator_arg_t, const allocator_type& alloc, Args&&... args)
+            : json_object(construct_with_allocator(typename std::is_constructible<json_object,Args&&...,const allocator_type&>::type(),
+                                                   alloc, std::forward<Args>(args)...))
+        {
+        }
+
+        // The arguments are passed on with the allocator when json_object can be constructed from them that way
+        template <class... Args>
+        static json_object construct_with_allocator(std::true_type, const allocator_type& alloc, Args&&... args)
+        {
+            return json_object(std::forward<Args>(args)..., alloc);
+        }
+
+        template <class... Args>
+        static json_object construct_with_allocator(std::false_type, const allocator_type&, Args&&... args)
+        {
+            return json_object(std::forward<Args>(args)...);
+        }
+
         template<class InputIt>
         json_object(InputIt first, InputIt last)
         {
@@ -753,6 +866,21 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
+            end_append();
+        }
+
+        // Appends a member without ordering or checking for duplicate names, for building 
+        // an object in place. end_append() must be called before the object is otherwise used.
+        template <class... Args>
+        Json& append(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
+
+        // Orders the members appended with append(), keeping the first of any duplicate names
+        void end_append()
+        {
             std::stable_sort(members_.begin(),members_.end(),
                              [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
             auto it = std::unique(members_.begin(), members_.end(),
@@ -1210,27 +1338,31 @@ namespace jsoncons {
         json_object& operator=(const json_object&) = delete;
     };
 
-    // Preserve order
+    // Preserve order, and hashed
+
+    // The members are kept in insertion order in a dense sequence, with a compact hash 
+    // index of their positions. With preserve_key_order, objects compare as sequences 
+    // of members, with hash_key_order, as sets of members.
     template <class KeyT,class Json>
-    class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,preserve_key_order>::value>::type> : 
+    class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,preserve_key_order>::value ||
+                                                        std::is_same<typename Json::implementation_policy::key_order,hash_key_order>::value>::type> : 
         public allocator_holder<typename Json::allocator_type>
     {
     public:
         using allocator_type = typename Json::allocator_type;
         using char_type = typename Json::char_type;
         using key_type = KeyT;
-        //using mapped_type = Json;
         using string_view_type = typename Json::string_view_type;
         using key_value_type = key_value<KeyT,Json>;
     private:
         using implementation_policy = typename Json::implementation_policy;
         using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
         using key_value_container_type = typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>;
-        typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t> index_allocator_type;
-        using index_container_type = typename implementation_policy::template sequence_container_type<std::size_t,index_allocator_type>;
+        using index_type = jsoncons::detail::hash_index<allocator_type>;
 
+        // The members in insertion order, and a hash index of their positions
         key_value_container_type members_;
-        index_container_type index_;
+        index_type index_;
     public:
         using iterator = typename key_value_container_type::iterator;
         using const_iterator = typename key_value_container_type::const_iterator;
@@ -1243,7 +1375,7 @@ namespace jsoncons {
         json_object(const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(alloc)
         {
         }
 
@@ -1264,15 +1396,51 @@ namespace jsoncons {
         json_object(const json_object& val, const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
               members_(val.members_,key_value_allocator_type(alloc)),
-              index_(val.index_,index_allocator_type(alloc))
+              index_(val.index_,alloc)
         {
         }
 
         json_object(json_object&& val,const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
               members_(std::move(val.members_),key_value_allocator_type(alloc)),
-              index_(std::move(val.index_),index_allocator_type(alloc))
+              index_(std::move(val.index_),alloc)
+        {
+        }
+
+        // Uses-allocator construction, see basic_json
+        json_object(std::allocator_arg_t, const allocator_type& alloc, const json_object& val)
+            : json_object(val, alloc)
+        {
+        }
+
+        json_object(std::allocator_arg_t, const allocator_type& alloc, json_object& val)
+            : json_object(val, alloc)
+        {
+        }
+
+        json_object(std::allocator_arg_t, const allocator_type& alloc, json_object&& val)
+            : json_object(std::move(val), alloc)
+        {
+        }
+
+        template <class... Args>
+        json_object(std::allocator_arg_t, const allocator_type& alloc, Args&&... args)
+            : json_object(construct_with_allocator(typename std::is_constructible<json_object,Args&&...,const allocator_type&>::type(),
+                                                   alloc, std::forward<Args>(args)...))
+        {
+        }
+
+        // The arguments are passed on with the allocator when json_object can be constructed from them that way
+        template <class... Args>
+        static json_object construct_with_allocator(std::true_type, const allocator_type& alloc, Args&&... args)
+        {
+            return json_object(std::forward<Args>(args)..., alloc);
+        }
+
+        template <class... Args>
+        static json_object construct_with_allocator(std::false_type, const allocator_type&, Args&&... args)
         {
+            return json_object(std::forward<Args>(args)...);
         }
 
         template<class InputIt>
@@ -1284,30 +1452,7 @@ namespace jsoncons {
             {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
-
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            index_.build_unique(members_);
         }
 
         template<class InputIt>
@@ -1315,7 +1460,7 @@ namespace jsoncons {
                     const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(alloc)
         {
             std::size_t count = std::distance(first,last);
             members_.reserve(count);
@@ -1323,37 +1468,14 @@ namespace jsoncons {
             {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
-
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
-
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+            index_.build_unique(members_);
         }
 
         json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
                     const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(alloc)
         {
             members_.reserve(init.size());
             for (auto& item : init)
@@ -1370,6 +1492,7 @@ namespace jsoncons {
         void swap(json_object& val) noexcept
         {
             members_.swap(val.members_);
+            index_.swap(val.index_);
         }
 
         iterator begin()
@@ -1434,30 +1557,14 @@ namespace jsoncons {
 
         iterator find(const string_view_type& name) noexcept
         {
-            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
-            if (it != index_.end() && members_.at(*it).key() == name)
-            {
-                return members_.begin() + *it;
-            }
-            else
-            {
-                return members_.end();
-            }
+            std::size_t pos = index_.find(members_, name);
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
         }
 
         const_iterator find(const string_view_type& name) const noexcept
         {
-            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
-            if (it != index_.end() && members_.at(*it).key() == name)
-            {
-                return members_.begin() + *it;
-            }
-            else
-            {
-                return members_.end();
-            }
+            std::size_t pos = index_.find(members_, name);
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
         }
 
         void erase(const_iterator first, const_iterator last) 
@@ -1467,7 +1574,7 @@ namespace jsoncons {
 
             if (pos1 < members_.size() && pos2 <= members_.size())
             {
-                erase_index_entries(pos1,pos2);
+                index_.erase(members_, pos1, pos2);
 
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
                 iterator it1 = members_.begin() + (first - members_.begin());
@@ -1476,25 +1583,16 @@ namespace jsoncons {
     #else
                 members_.erase(first,last);
     #endif
-                //build_index();
             }
         }
 
         void erase(const string_view_type& name) 
         {
-            auto pos = find(name);
-            if (pos != members_.end())
+            std::size_t pos = index_.find(members_, name);
+            if (pos != index_type::npos)
             {
-                std::size_t pos1 = pos - members_.begin();
-                std::size_t pos2 = pos1 + 1;
-
-                erase_index_entries(pos1, pos2);
-    #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
-                iterator it = members_.begin() + (pos - members_.begin());
-                members_.erase(it);
-    #else
-                members_.erase(pos);
-    #endif
+                index_.erase(members_, pos, pos+1);
+                members_.erase(members_.begin() + pos);
             }
         }
 
@@ -1507,30 +1605,22 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
+            end_append();
+        }
 
-            build_index();
-            auto last_unique = std::unique(index_.begin(), index_.end(),
-                [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
-
-            if (last_unique != index_.end())
-            {
-                index_.erase(last_unique, index_.end());
-                std::sort(index_.begin(), index_.end());
+        // Appends a member without checking for duplicate names, for building an object 
+        // in place. end_append() must be called before the object is otherwise used.
+        template <class... Args>
+        Json& append(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
 
-                auto result = index_.rbegin();
-                if (*result != members_.size())
-                {
-                    members_.erase(members_.begin() + (*result + 1), members_.end());
-                }
-                for (auto it = index_.rbegin() + 1; it != index_.rend(); ++it, ++result)
-                {
-                    if (*result - *it > 1)
-                    {
-                        members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
-                    }
-                }
-            }
-            build_index();
+        // Indexes the members appended with append(), keeping the first of any duplicate names
+        void end_append()
+        {
+            index_.build_unique(members_);
         }
 
         template<class InputIt, class Convert>
@@ -1543,24 +1633,23 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
-
-            build_index();
+            index_.build(members_);
         }
 
         template <class T, class A=allocator_type>
         typename std::enable_if<jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
         insert_or_assign(const string_view_type& name, T&& value)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = index_.find(members_, name);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_.insert(members_, members_.size()-1);
+                return std::make_pair(members_.end()-1,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 it->value(Json(std::forward<T>(value)));
                 return std::make_pair(it,false);
             }
@@ -1570,17 +1659,17 @@ namespace jsoncons {
         typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
         insert_or_assign(const string_view_type& name, T&& value)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = index_.find(members_, name);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), 
                                       std::forward<T>(value),get_allocator());
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_.insert(members_, members_.size()-1);
+                return std::make_pair(members_.end()-1,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
+                auto it = members_.begin() + pos;
                 it->value(Json(std::forward<T>(value),get_allocator()));
                 return std::make_pair(it,false);
             }
@@ -1595,22 +1684,19 @@ namespace jsoncons {
                 auto result = insert_or_assign(key, std::forward<T>(value));
                 return result.first;
             }
+            std::size_t pos = index_.find(members_, key);
+            if (pos == index_type::npos)
+            {
+                pos = hint - members_.begin();
+                auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<T>(value));
+                index_.insert(members_, pos);
+                return it;
+            }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key,pos);
-
-                if (result.second)
-                {
-                    auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<T>(value));
-                    return it;
-                }
-                else
-                {
-                    auto it = members_.begin() + result.first;
-                    it->value(Json(std::forward<T>(value)));
-                    return it;
-                }
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value)));
+                return it;
             }
         }
 
@@ -1623,24 +1709,21 @@ namespace jsoncons {
                 auto result = insert_or_assign(key, std::forward<T>(value));
                 return result.first;
             }
+            std::size_t pos = index_.find(members_, key);
+            if (pos == index_type::npos)
+            {
+                pos = hint - members_.begin();
+                auto it = members_.emplace(hint, 
+                                           key_type(key.begin(),key.end(),get_allocator()), 
+                                           std::forward<T>(value),get_allocator());
+                index_.insert(members_, pos);
+                return it;
+            }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key,pos);
-
-                if (result.second)
-                {
-                    auto it = members_.emplace(hint, 
-                                               key_type(key.begin(),key.end(),get_allocator()), 
-                                               std::forward<T>(value),get_allocator());
-                    return it;
-                }
-                else
-                {
-                    auto it = members_.begin() + result.first;
-                    it->value(Json(std::forward<T>(value),get_allocator()));
-                    return it;
-                }
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value),get_allocator()));
+                return it;
             }
         }
 
@@ -1783,17 +1866,16 @@ namespace jsoncons {
         typename std::enable_if<jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
         try_emplace(const string_view_type& name, Args&&... args)
         {
-            auto result = insert_index_entry(name,members_.size());
-            if (result.second)
+            std::size_t pos = index_.find(members_, name);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_.insert(members_, members_.size()-1);
+                return std::make_pair(members_.end()-1,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,false);
+                return std::make_pair(members_.begin() + pos,false);
             }
         }
 
@@ -1801,18 +1883,17 @@ namespace jsoncons {
         typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
         try_emplace(const string_view_type& key, Args&&... args)
         {
-            auto result = insert_index_entry(key,members_.size());
-            if (result.second)
+            std::size_t pos = index_.find(members_, key);
+            if (pos == index_type::npos)
             {
                 members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
                                       std::forward<Args>(args)...);
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,true);
+                index_.insert(members_, members_.size()-1);
+                return std::make_pair(members_.end()-1,true);
             }
             else
             {
-                auto it = members_.begin() + result.first;
-                return std::make_pair(it,false);
+                return std::make_pair(members_.begin() + pos,false);
             }
         }
      
@@ -1825,21 +1906,17 @@ namespace jsoncons {
                 auto result = try_emplace(key, std::forward<Args>(args)...);
                 return result.first;
             }
+            std::size_t pos = index_.find(members_, key);
+            if (pos == index_type::npos)
+            {
+                pos = hint - members_.begin();
+                auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<Args>(args)...);
+                index_.insert(members_, pos);
+                return it;
+            }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key, pos);
-
-                if (result.second)
-                {
-                    auto it = members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<Args>(args)...);
-                    return it;
-                }
-                else
-                {
-                    auto it = members_.begin() + result.first;
-                    return it;
-                }
+                return members_.begin() + pos;
             }
         }
 
@@ -1852,134 +1929,98 @@ namespace jsoncons {
                 auto result = try_emplace(key, std::forward<Args>(args)...);
                 return result.first;
             }
+            std::size_t pos = index_.find(members_, key);
+            if (pos == index_type::npos)
+            {
+                pos = hint - members_.begin();
+                auto it = members_.emplace(hint, 
+                                           key_type(key.begin(),key.end(), get_allocator()), 
+                                           std::forward<Args>(args)...);
+                index_.insert(members_, pos);
+                return it;
+            }
             else
             {
-                std::size_t pos = hint - members_.begin();
-                auto result = insert_index_entry(key, pos);
-
-                if (result.second)
-                {
-                    auto it = members_.emplace(hint, 
-                                               key_type(key.begin(),key.end(), get_allocator()), 
-                                               std::forward<Args>(args)...);
-                    return it;
-                }
-                else
-                {
-                    auto it = members_.begin() + result.first;
-                    return it;
-                }
+                return members_.begin() + pos;
             }
         }
 
         bool operator==(const json_object& rhs) const
         {
-            return members_ == rhs.members_;
+            return equal(rhs, typename implementation_policy::key_order());
         }
      
         bool operator<(const json_object& rhs) const
         {
-            return members_ < rhs.members_;
+            return less(rhs, typename implementation_policy::key_order());
         }
     private:
 
-        void destroy() noexcept
+        bool equal(const json_object& rhs, preserve_key_order) const
         {
-            if (!members_.empty())
-            {
-                json_array<Json> temp(get_allocator());
-
-                for (auto&& kv : members_)
-                {
-                    if (kv.value().size() > 0)
-                    {
-                        temp.emplace_back(std::move(kv.value()));
-                        assert(kv.value().size() == 0);
-                    }
-                }
-            }
+            return members_ == rhs.members_;
         }
 
-        std::pair<std::size_t,bool> insert_index_entry(const string_view_type& key, std::size_t pos)
+        bool less(const json_object& rhs, preserve_key_order) const
         {
-            JSONCONS_ASSERT(pos <= index_.size());
-
-            auto it = std::lower_bound(index_.begin(),index_.end(), key, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
+            return members_ < rhs.members_;
+        }
 
-            if (it == index_.end())
+        // Objects are equal if they have the same members, in any order
+        bool equal(const json_object& rhs, hash_key_order) const
+        {
+            if (members_.size() != rhs.members_.size())
             {
-                std::size_t count = index_.size() - pos;
-                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
-                {
-                    if (index_[i] >= pos)
-                    {
-                        ++index_[i];
-                        --count;
-                    }
-                }
-                index_.push_back(pos);
-                return std::make_pair(pos,true);
+                return false;
             }
-            else if (members_.at(*it).key() != key)
+            for (const auto& member : members_)
             {
-                std::size_t count = index_.size() - pos;
-                for (std::size_t i = 0; count > 0 && i < index_.size(); ++i)
+                auto it = rhs.find(member.key());
+                if (it == rhs.members_.end() || !(it->value() == member.value()))
                 {
-                    if (index_[i] >= pos)
-                    {
-                        ++index_[i];
-                        --count;
-                    }
+                    return false;
                 }
-                auto it2 = index_.insert(it, pos);
-                return std::make_pair(*it2,true);
-            }
-            else
-            {
-                return std::make_pair(*it,false);
             }
+            return true;
         }
-
-        void erase_index_entries(std::size_t pos1, std::size_t pos2)
+     
+        // Compares the members ordered by name, as with sorted_policy
+        bool less(const json_object& rhs, hash_key_order) const
         {
-            JSONCONS_ASSERT(pos1 <= pos2);
-            JSONCONS_ASSERT(pos2 <= index_.size());
+            auto a = sorted_members();
+            auto b = rhs.sorted_members();
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                                [](const key_value_type* x, const key_value_type* y) -> bool {return *x < *y;});
+        }
 
-            const size_t offset = pos2 - pos1;
-            const size_t n = index_.size() - offset;
-            for (std::size_t i = 0; i < index_.size(); ++i)
-            {
-                if (offset == index_.size())
-                {
-                    index_.erase(index_.begin()+i,index_.end());
-                    i += offset;
-                }
-                else if (index_[i] >= pos1 && index_[i] < pos2)
-                {
-                    index_.erase(index_.begin()+i);
-                }
-            }
-            for (std::size_t i = 0; i < index_.size(); ++i)
+        std::vector<const key_value_type*> sorted_members() const
+        {
+            std::vector<const key_value_type*> v;
+            v.reserve(members_.size());
+            for (const auto& member : members_)
             {
-                if (index_[i] >= pos2)
-                {
-                    index_[i] -= offset;
-                }
+                v.push_back(std::addressof(member));
             }
-            JSONCONS_ASSERT(index_.size() == n);
+            std::sort(v.begin(), v.end(), 
+                      [](const key_value_type* x, const key_value_type* y) -> bool {return x->key().compare(y->key()) < 0;});
+            return v;
         }
 
-        void build_index()
+        void destroy() noexcept
         {
-            index_.clear();
-            index_.reserve(members_.size());
-            for (std::size_t i = 0; i < members_.size(); ++i)
+            if (!members_.empty())
             {
-                index_.push_back(i);
+                json_array<Json> temp(get_allocator());
+
+                for (auto&& kv : members_)
+                {
+                    if (kv.value().size() > 0)
+                    {
+                        temp.emplace_back(std::move(kv.value()));
+                        assert(kv.value().size() == 0);
+                    }
+                }
             }
-            std::stable_sort(index_.begin(),index_.end(),
-                             [&](std::size_t a, std::size_t b) -> bool {return members_.at(a).key().compare(members_.at(b).key()) < 0;});
         }
 
         json_object& operator=(const json_object&) = delete;
@@ -58,7 +58,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(accept_all),
          buffer_(alloc),
@@ -145,7 +145,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(accept_all),
          buffer_(alloc),
@@ -244,31 +244,94 @@ public:
         read_next(ec);
     }
 
-    void read_buffer(std::error_code& ec)
+    // Moves toward the next event, parsing at most max_chars characters. Returns
+    // true if the cursor reached the next event, or false if the budget ran out
+    // first, in which case a later call resumes where this one stopped.
+    bool next(std::size_t max_chars)
+    {
+        std::error_code ec;
+        bool reached = next(max_chars, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+        return reached;
+    }
+
+    bool next(std::size_t max_chars, std::error_code& ec)
+    {
+        parser_.restart();
+        while (!parser_.stopped())
+        {
+            if (parser_.source_exhausted())
+            {
+                if (!source_.eof())
+                {
+                    read_buffer(ec);
+                    if (ec) return false;
+                }
+                else
+                {
+                    eof_ = true;
+                }
+            }
+            else if (max_chars == 0)
+            {
+                return false;
+            }
+            max_chars -= parser_.parse_some(cursor_visitor_, max_chars, ec);
+            if (ec) return false;
+        }
+        return true;
+    }
+
+    // Sources that hold their input in memory hand it to the parser in place,
+    // so strings without escapes reach the visitor without being copied
+    template <class S = Src>
+    typename std::enable_if<has_read_buffer<S>::value>::type
+    read_buffer(std::error_code& ec)
+    {
+        auto s = source_.read_buffer();
+        update_parser(s.data(), s.size(), ec);
+    }
+
+    template <class S = Src>
+    typename std::enable_if<!has_read_buffer<S>::value>::type
+    read_buffer(std::error_code& ec)
     {
         buffer_.clear();
         buffer_.resize(buffer_length_);
         std::size_t count = source_.read(buffer_.data(), buffer_length_);
         buffer_.resize(static_cast<std::size_t>(count));
-        if (buffer_.size() == 0)
+        if (source_.is_error())
+        {
+            ec = json_errc::source_error;
+            return;
+        }
+        update_parser(buffer_.data(), buffer_.size(), ec);
+    }
+
+    void update_parser(const CharT* data, std::size_t length, std::error_code& ec)
+    {
+        if (length == 0)
         {
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(data, data+length);
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            std::size_t offset = result.it - buffer_.begin();
-            parser_.update(buffer_.data()+offset,buffer_.size()-offset);
+            std::size_t offset = result.it - data;
+            parser_.update(data+offset,length-offset);
             begin_ = false;
         }
         else
         {
-            parser_.update(buffer_.data(),buffer_.size());
+            parser_.update(data,length);
         }
     }
 
@@ -356,7 +419,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
@@ -452,7 +515,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
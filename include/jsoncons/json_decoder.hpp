@@ -11,10 +11,10 @@
 #include <vector>
 #include <type_traits> // std::true_type
 #include <memory> // std::allocator
-#include <iterator> // std::make_move_iterator
 #include <utility> // std::move
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/counting_allocator.hpp>
 
 namespace jsoncons {
 
@@ -35,53 +35,37 @@ public:
     using json_object_allocator = typename object::allocator_type;
     typedef typename std::allocator_traits<result_allocator_type>:: template rebind_alloc<uint8_t> json_byte_allocator_type;
 private:
-    struct stack_item
-    {
-        key_type name_;
-        Json value_;
-
-        template <class... Args>
-        stack_item(key_type&& name, Args&& ... args)
-            : name_(std::move(name)), value_(std::forward<Args>(args)...)
-        {
-        }
-
-        stack_item() = default;
-        stack_item(const stack_item&) = default;
-        stack_item(stack_item&&) = default;
-        stack_item& operator=(const stack_item&) = default;
-        stack_item& operator=(stack_item&&) = default;
-    };
-
     enum class structure_type {root_t, array_t, object_t};
 
+    // Values are constructed in place in the container on top of the structure stack. 
+    // A container only grows while it is on top, so the pointers below it stay valid.
     struct structure_info
     {
         structure_type type_;
-        std::size_t container_index_;
+        Json* container_;
 
-        structure_info(structure_type type, std::size_t offset)
-            : type_(type), container_index_(offset)
+        structure_info(structure_type type, Json* container)
+            : type_(type), container_(container)
         {
         }
 
     };
 
+    // Length hints larger than this are not trusted to presize a container 
+    static constexpr std::size_t max_reserve_hint = 4096;
+
     using temp_allocator_type = TempAllocator;
-    typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info> structure_info_allocator_type;
  
     json_string_allocator string_allocator_;
     json_byte_allocator_type byte_allocator_;
     json_object_allocator object_allocator_;
     json_array_allocator array_allocator_;
-    stack_item_allocator_type stack_item_allocator_;
     structure_info_allocator_type size_t_allocator_;
 
     Json result_;
 
     key_type name_;
-    std::vector<stack_item,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
     bool is_valid_;
 
@@ -91,18 +75,15 @@ public:
           byte_allocator_(result_allocator_type()),
           object_allocator_(result_allocator_type()),
           array_allocator_(result_allocator_type()),
-          stack_item_allocator_(temp_alloc),
           size_t_allocator_(temp_alloc),
           result_(),
           name_(string_allocator_),
-          item_stack_(stack_item_allocator_),
           structure_stack_(size_t_allocator_),
           is_valid_(false) 
 
     {
-        item_stack_.reserve(1000);
         structure_stack_.reserve(100);
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
     }
 
     json_decoder(result_allocator_arg_t,
@@ -111,18 +92,15 @@ public:
           byte_allocator_(result_alloc),
           object_allocator_(result_alloc),
           array_allocator_(result_alloc),
-          stack_item_allocator_(),
           size_t_allocator_(),
           result_(),
           name_(string_allocator_),
-          item_stack_(),
           structure_stack_(),
           is_valid_(false) 
 
     {
-        item_stack_.reserve(1000);
         structure_stack_.reserve(100);
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
     }
 
     json_decoder(result_allocator_arg_t,
@@ -132,26 +110,22 @@ public:
           byte_allocator_(result_alloc),
           object_allocator_(result_alloc),
           array_allocator_(result_alloc),
-          stack_item_allocator_(temp_alloc),
           size_t_allocator_(temp_alloc),
           result_(),
           name_(string_allocator_),
-          item_stack_(stack_item_allocator_),
           structure_stack_(size_t_allocator_),
           is_valid_(false) 
 
     {
-        item_stack_.reserve(1000);
         structure_stack_.reserve(100);
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
     }
 
     void reset()
     {
         is_valid_ = false;
-        item_stack_.clear();
         structure_stack_.clear();
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
     }
 
     bool is_valid() const
@@ -174,262 +148,178 @@ public:
 #endif
 
 private:
-
-    void visit_flush() override
+    // Stops with an error once the budget of a counting_allocator is exceeded
+    bool check_allocation(std::error_code& ec) const
     {
+        if (JSONCONS_UNLIKELY(jsoncons::detail::allocation_budget_exceeded(string_allocator_) ||
+                              jsoncons::detail::allocation_budget_exceeded(size_t_allocator_)))
+        {
+            ec = json_errc::max_allocation_exceeded;
+            return false;
+        }
+        return true;
     }
 
-    bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+    // Constructs a value in place in the current container, or as the result
+    template <class... Args>
+    Json& emplace_value(Args&&... args)
     {
-        if (structure_stack_.back().type_ == structure_type::root_t)
+        structure_info& current = structure_stack_.back();
+        switch (current.type_)
         {
-            item_stack_.clear();
-            is_valid_ = false;
+            case structure_type::object_t:
+                return current.container_->object_value().append(std::move(name_), std::forward<Args>(args)...);
+            case structure_type::array_t:
+                return current.container_->array_value().emplace_back(std::forward<Args>(args)...);
+            default:
+                result_ = Json(std::forward<Args>(args)...);
+                return result_;
         }
-        item_stack_.emplace_back(std::forward<key_type>(name_), json_object_arg, tag, object_allocator_);
-        structure_stack_.emplace_back(structure_type::object_t, item_stack_.size()-1);
-        return true;
     }
 
-    bool visit_end_object(const ser_context&, std::error_code&) override
+    bool end_value(std::error_code& ec)
     {
-        JSONCONS_ASSERT(structure_stack_.size() > 0);
-        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
-        const size_t structure_index = structure_stack_.back().container_index_;
-        JSONCONS_ASSERT(item_stack_.size() > structure_index);
-        const size_t count = item_stack_.size() - (structure_index + 1);
-        auto first = item_stack_.begin() + (structure_index+1);
-        auto last = first + count;
-        item_stack_[structure_index].value_.object_value().insert(
-            std::make_move_iterator(first),
-            std::make_move_iterator(last),
-            [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));}
-        );
-        item_stack_.erase(item_stack_.begin()+structure_index+1, item_stack_.end());
-        structure_stack_.pop_back();
         if (structure_stack_.back().type_ == structure_type::root_t)
         {
-            result_.swap(item_stack_.front().value_);
-            item_stack_.pop_back();
-            is_valid_ = true;
+            is_valid_ = check_allocation(ec);
             return false;
         }
-        return true;
+        return check_allocation(ec);
     }
 
-    bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+    void visit_flush() override
+    {
+    }
+
+    bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code& ec) override
     {
         if (structure_stack_.back().type_ == structure_type::root_t)
         {
-            item_stack_.clear();
             is_valid_ = false;
         }
-        item_stack_.emplace_back(std::forward<key_type>(name_), json_array_arg, tag, array_allocator_);
-        structure_stack_.emplace_back(structure_type::array_t, item_stack_.size()-1);
-        return true;
+        Json& container = emplace_value(json_object_arg, tag, object_allocator_);
+        structure_stack_.emplace_back(structure_type::object_t, std::addressof(container));
+        return check_allocation(ec);
     }
 
-    bool visit_end_array(const ser_context&, std::error_code&) override
+    bool visit_begin_object(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
     {
-        JSONCONS_ASSERT(structure_stack_.size() > 1);
-        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::array_t);
-        const size_t container_index = structure_stack_.back().container_index_;
-        JSONCONS_ASSERT(item_stack_.size() > container_index);
-
-        auto& container = item_stack_[container_index].value_;
+        bool more = visit_begin_object(tag, context, ec);
+        structure_stack_.back().container_->object_value().reserve(length < max_reserve_hint ? length : std::size_t(max_reserve_hint));
+        return more && check_allocation(ec);
+    }
 
-        const size_t size = item_stack_.size() - (container_index + 1);
-        //std::cout << "size on item stack: " << size << "\n";
+    bool visit_end_object(const ser_context&, std::error_code& ec) override
+    {
+        JSONCONS_ASSERT(structure_stack_.size() > 1);
+        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
+        structure_stack_.back().container_->object_value().end_append();
+        structure_stack_.pop_back();
+        return end_value(ec);
+    }
 
-        if (size > 0)
+    bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code& ec) override
+    {
+        if (structure_stack_.back().type_ == structure_type::root_t)
         {
-            container.reserve(size);
-            auto first = item_stack_.begin() + (container_index+1);
-            auto last = first + size;
-            for (auto it = first; it != last; ++it)
-            {
-                container.push_back(std::move(it->value_));
-            }
-            item_stack_.erase(first, item_stack_.end());
+            is_valid_ = false;
         }
+        Json& container = emplace_value(json_array_arg, tag, array_allocator_);
+        structure_stack_.emplace_back(structure_type::array_t, std::addressof(container));
+        return check_allocation(ec);
+    }
+
+    bool visit_begin_array(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        bool more = visit_begin_array(tag, context, ec);
+        structure_stack_.back().container_->array_value().reserve(length < max_reserve_hint ? length : std::size_t(max_reserve_hint));
+        return more && check_allocation(ec);
+    }
 
+    bool visit_end_array(const ser_context&, std::error_code& ec) override
+    {
+        JSONCONS_ASSERT(structure_stack_.size() > 1);
+        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::array_t);
         structure_stack_.pop_back();
-        if (structure_stack_.back().type_ == structure_type::root_t)
-        {
-            result_.swap(item_stack_.front().value_);
-            item_stack_.pop_back();
-            is_valid_ = true;
-            return false;
-        }
-        return true;
+        return end_value(ec);
     }
 
-    bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+    bool visit_key(const string_view_type& name, const ser_context&, std::error_code& ec) override
     {
         name_ = key_type(name.data(),name.length(),string_allocator_);
-        return true;
+        return check_allocation(ec);
     }
 
-    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), sv, tag, string_allocator_);
-                break;
-            case structure_type::root_t:
-                result_ = Json(sv, tag, string_allocator_);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(sv, tag, string_allocator_);
+        return end_value(ec);
     }
 
     bool visit_byte_string(const byte_string_view& b, 
                            semantic_tag tag, 
                            const ser_context&,
-                           std::error_code&) override
+                           std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), byte_string_arg, b, tag, byte_allocator_);
-                break;
-            case structure_type::root_t:
-                result_ = Json(byte_string_arg, b, tag, byte_allocator_);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(byte_string_arg, b, tag, byte_allocator_);
+        return end_value(ec);
     }
 
     bool visit_byte_string(const byte_string_view& b, 
                            uint64_t ext_tag, 
                            const ser_context&,
-                           std::error_code&) override
+                           std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), byte_string_arg, b, ext_tag, byte_allocator_);
-                break;
-            case structure_type::root_t:
-                result_ = Json(byte_string_arg, b, ext_tag, byte_allocator_);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(byte_string_arg, b, ext_tag, byte_allocator_);
+        return end_value(ec);
     }
 
     bool visit_int64(int64_t value, 
                         semantic_tag tag, 
                         const ser_context&,
-                        std::error_code&) override
+                        std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value,tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value(ec);
     }
 
     bool visit_uint64(uint64_t value, 
                          semantic_tag tag, 
                          const ser_context&,
-                         std::error_code&) override
+                         std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value,tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value(ec);
     }
 
     bool visit_half(uint16_t value, 
                        semantic_tag tag,   
                        const ser_context&,
-                       std::error_code&) override
+                       std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), half_arg, value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(half_arg, value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(half_arg, value, tag);
+        return end_value(ec);
     }
 
     bool visit_double(double value, 
                          semantic_tag tag,   
                          const ser_context&,
-                         std::error_code&) override
+                         std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value(ec);
     }
 
-    bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+    bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value(ec);
     }
 
-    bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+    bool visit_null(semantic_tag tag, const ser_context&, std::error_code& ec) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), null_type(), tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(null_type(), tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(null_type(), tag);
+        return end_value(ec);
     }
 };
 
@@ -43,7 +43,10 @@ namespace jsoncons {
         over_long_utf8_sequence,
         illegal_codepoint,
         illegal_surrogate_value,
-        unpaired_high_surrogate
+        unpaired_high_surrogate,
+        max_input_length_exceeded,
+        max_string_length_exceeded,
+        max_allocation_exceeded
     };
 
     class json_error_category_impl
@@ -116,6 +119,12 @@ namespace jsoncons {
                     return "UTF-16 surrogate values are illegal in UTF-32";
                 case json_errc::unpaired_high_surrogate:
                     return "Expected low surrogate following the high surrogate";
+                case json_errc::max_input_length_exceeded:
+                    return "Input length exceeds limit in options";
+                case json_errc::max_string_length_exceeded:
+                    return "String length exceeds limit in options";
+                case json_errc::max_allocation_exceeded:
+                    return "Allocated memory exceeds limit of allocation budget";
                default:
                     return "Unknown JSON parser error";
                 }
@@ -0,0 +1,378 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <istream>
+#include <thread>
+#include <exception> // std::exception_ptr
+#include <algorithm> // std::find
+#include <system_error>
+#include <utility> // std::move
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/worker_pool.hpp>
+
+namespace jsoncons {
+
+// basic_json_lines_reader reads newline delimited JSON (one value per line, blank
+// lines are skipped.) The input is read in batches of at most thread_count*chunk_size
+// characters, each batch is split into newline aligned chunks, and the chunks are
+// parsed concurrently, one basic_json_parser per thread. Values are delivered in
+// input order after each batch, so memory use is bounded by the batch size and the
+// values decoded from one batch. A line longer than a batch is read whole. The
+// worker threads are started for the first batch and kept until the reader is
+// destroyed. The limits in the options, including max_input_length, apply to
+// each line.
+
+template <class CharT,class TempAllocator=std::allocator<char>>
+class basic_json_lines_reader : public ser_context
+{
+public:
+    using char_type = CharT;
+    using string_view_type = jsoncons::basic_string_view<CharT>;
+
+    static constexpr std::size_t default_chunk_size = 1024*1024;
+private:
+    using parser_type = basic_json_parser<CharT,TempAllocator>;
+
+    struct chunk
+    {
+        const CharT* first;
+        const CharT* last;
+        std::size_t lines;
+        std::size_t error_line;
+        std::size_t error_column;
+        std::error_code ec;
+        std::exception_ptr exception;
+
+        chunk(const CharT* begin, const CharT* end)
+            : first(begin), last(end), lines(0), error_line(0), error_column(0)
+        {
+        }
+    };
+
+    string_view_type text_;
+    std::basic_istream<CharT>* is_;
+    basic_json_decode_options<CharT> options_;
+    std::size_t thread_count_;
+    std::size_t chunk_size_;
+    TempAllocator alloc_;
+    std::vector<CharT> buffer_;
+    std::size_t line_;
+    std::size_t column_;
+    jsoncons::detail::worker_pool workers_;
+
+    // Noncopyable and nonmoveable
+    basic_json_lines_reader(const basic_json_lines_reader&) = delete;
+    basic_json_lines_reader& operator=(const basic_json_lines_reader&) = delete;
+public:
+    // A thread_count of 0 means std::thread::hardware_concurrency()
+    basic_json_lines_reader(const string_view_type& text,
+                            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                            std::size_t thread_count = 0,
+                            std::size_t chunk_size = default_chunk_size,
+                            const TempAllocator& alloc = TempAllocator())
+        : text_(text), is_(nullptr), options_(options),
+          thread_count_(resolve_thread_count(thread_count)),
+          chunk_size_(chunk_size > 0 ? chunk_size : 1),
+          alloc_(alloc), line_(0), column_(0)
+    {
+    }
+
+    basic_json_lines_reader(std::basic_istream<CharT>& is,
+                            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                            std::size_t thread_count = 0,
+                            std::size_t chunk_size = default_chunk_size,
+                            const TempAllocator& alloc = TempAllocator())
+        : is_(std::addressof(is)), options_(options),
+          thread_count_(resolve_thread_count(thread_count)),
+          chunk_size_(chunk_size > 0 ? chunk_size : 1),
+          alloc_(alloc), line_(0), column_(0)
+    {
+    }
+
+    std::size_t thread_count() const
+    {
+        return thread_count_;
+    }
+
+    // Decodes each line into a Json value and passes it to f, in input order
+    template <class Json,class F>
+    void read(F f)
+    {
+        std::error_code ec;
+        read<Json>(f, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+    }
+
+    template <class Json,class F>
+    void read(F f, std::error_code& ec)
+    {
+        std::vector<std::vector<Json>> values(thread_count_);
+
+        auto parse = [&](std::vector<chunk>& chunks, std::size_t i)
+        {
+            values[i].clear();
+            json_decoder<Json,TempAllocator> decoder(alloc_);
+            parse_chunk(chunks[i], decoder, [&]() {values[i].push_back(decoder.get_result());});
+        };
+        auto deliver = [&](const chunk&, std::size_t i)
+        {
+            for (auto& val : values[i])
+            {
+                f(std::move(val));
+            }
+        };
+        read_batches(parse, deliver, thread_count_, ec);
+    }
+
+    // Parses the lines of each batch with one visitor per thread, the i-th chunk of a
+    // batch goes to visitors[i]. Each visitor receives the values of its chunks in input
+    // order. After an error, the other visitors may already have received values
+    // from lines that follow the line in error.
+    void read(const std::vector<basic_json_visitor<CharT>*>& visitors)
+    {
+        std::error_code ec;
+        read(visitors, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+    }
+
+    void read(const std::vector<basic_json_visitor<CharT>*>& visitors, std::error_code& ec)
+    {
+        if (visitors.empty())
+        {
+            return;
+        }
+        auto parse = [&](std::vector<chunk>& chunks, std::size_t i)
+        {
+            parse_chunk(chunks[i], *visitors[i], [](){});
+        };
+        auto deliver = [](const chunk&, std::size_t) {};
+        read_batches(parse, deliver, visitors.size(), ec);
+    }
+
+    // The line and column of the error, if any
+    std::size_t line() const override
+    {
+        return line_;
+    }
+
+    std::size_t column() const override
+    {
+        return column_;
+    }
+
+private:
+    static std::size_t resolve_thread_count(std::size_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        return thread_count > 0 ? thread_count : 1;
+    }
+
+    static bool is_blank(const CharT* first, const CharT* last)
+    {
+        for (; first != last; ++first)
+        {
+            switch (*first)
+            {
+                case ' ':
+                case '\t':
+                case '\r':
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Parses the lines of a chunk, calling on_value after each value
+    template <class OnValue>
+    void parse_chunk(chunk& c, basic_json_visitor<CharT>& visitor, OnValue on_value)
+    {
+        JSONCONS_TRY
+        {
+            parser_type parser(options_, alloc_);
+            const CharT* p = c.first;
+            while (p != c.last)
+            {
+                const CharT* eol = std::find(p, c.last, '\n');
+                ++c.lines;
+                if (!is_blank(p, eol))
+                {
+                    parser.reset();
+                    parser.update(p, eol - p);
+                    parser.finish_parse(visitor, c.ec);
+                    if (!c.ec)
+                    {
+                        parser.check_done(c.ec);
+                    }
+                    if (c.ec)
+                    {
+                        c.error_line = c.lines;
+                        c.error_column = parser.column();
+                        return;
+                    }
+                    on_value();
+                }
+                p = eol == c.last ? eol : eol + 1;
+            }
+        }
+        JSONCONS_CATCH(...)
+        {
+            c.exception = std::current_exception();
+        }
+    }
+
+    // Splits [first,last) into at most n newline aligned chunks
+    static void split(const CharT* first, const CharT* last, std::size_t n, std::vector<chunk>& chunks)
+    {
+        chunks.clear();
+        std::size_t size = (last - first + n - 1) / n;
+        while (first != last)
+        {
+            const CharT* p = (std::size_t)(last - first) <= size ? last : first + size;
+            if (p != last)
+            {
+                p = std::find(p - 1, last, '\n');
+                if (p != last)
+                {
+                    ++p;
+                }
+            }
+            chunks.emplace_back(first, p);
+            first = p;
+        }
+    }
+
+    // Parses the chunks of a batch concurrently, then delivers them in order. Returns
+    // false after an error.
+    template <class Parse,class Deliver>
+    bool read_batch(const CharT* first, const CharT* last, std::size_t n,
+                    Parse parse, Deliver deliver, std::error_code& ec)
+    {
+        std::vector<chunk> chunks;
+        split(first, last, n, chunks);
+
+        workers_.run(chunks.size(), [&parse,&chunks](std::size_t i) {parse(chunks, i);});
+
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            deliver(chunks[i], i);
+            if (chunks[i].exception)
+            {
+                std::rethrow_exception(chunks[i].exception);
+            }
+            if (chunks[i].ec)
+            {
+                ec = chunks[i].ec;
+                line_ += chunks[i].error_line;
+                column_ = chunks[i].error_column;
+                return false;
+            }
+            line_ += chunks[i].lines;
+        }
+        return true;
+    }
+
+    template <class Parse,class Deliver>
+    void read_batches(Parse parse, Deliver deliver, std::size_t n, std::error_code& ec)
+    {
+        line_ = 0;
+        column_ = 0;
+        const std::size_t batch_size = n * chunk_size_;
+
+        if (is_ == nullptr)
+        {
+            const CharT* first = text_.data();
+            const CharT* end = text_.data() + text_.size();
+            while (first != end)
+            {
+                const CharT* last = (std::size_t)(end - first) <= batch_size ? end : first + batch_size;
+                if (last != end)
+                {
+                    last = std::find(last - 1, end, '\n');
+                    if (last != end)
+                    {
+                        ++last;
+                    }
+                }
+                if (!read_batch(first, last, n, parse, deliver, ec))
+                {
+                    return;
+                }
+                first = last;
+            }
+        }
+        else
+        {
+            // buffer_ holds the partial line left over from the previous batch
+            buffer_.clear();
+            bool eof = false;
+            while (!eof || !buffer_.empty())
+            {
+                std::size_t offset = buffer_.size();
+                std::size_t size = offset < batch_size ? batch_size : offset + chunk_size_;
+                buffer_.resize(size);
+                is_->read(buffer_.data() + offset, size - offset);
+                buffer_.resize(offset + static_cast<std::size_t>(is_->gcount()));
+                if (is_->bad())
+                {
+                    ec = json_errc::source_error;
+                    return;
+                }
+                if (is_->eof())
+                {
+                    eof = true;
+                }
+
+                // Complete lines only, unless at the end of the input
+                std::size_t length = buffer_.size();
+                if (!eof)
+                {
+                    while (length > offset && buffer_[length-1] != '\n')
+                    {
+                        --length;
+                    }
+                    if (length == offset)
+                    {
+                        // No line feed in what was read, read more
+                        continue;
+                    }
+                }
+                if (!read_batch(buffer_.data(), buffer_.data() + length, n, parse, deliver, ec))
+                {
+                    return;
+                }
+                buffer_.erase(buffer_.begin(), buffer_.begin() + length);
+            }
+        }
+    }
+};
+
+using json_lines_reader = basic_json_lines_reader<char>;
+using wjson_lines_reader = basic_json_lines_reader<wchar_t>;
+
+}
+
+#endif
+
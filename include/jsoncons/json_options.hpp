@@ -325,9 +325,13 @@ public:
     using typename super_type::string_type;
 private:
     bool lossless_number_:1;
+    std::size_t max_input_length_;
+    std::size_t max_string_length_;
 public:
     basic_json_decode_options()
-        : lossless_number_(false)
+        : lossless_number_(false),
+          max_input_length_((std::numeric_limits<std::size_t>::max)()),
+          max_string_length_((std::numeric_limits<std::size_t>::max)())
     {
     }
 
@@ -335,7 +339,9 @@ public:
 
     basic_json_decode_options(basic_json_decode_options&& other)
         : super_type(std::forward<basic_json_decode_options>(other)),
-                     lossless_number_(other.lossless_number_)
+                     lossless_number_(other.lossless_number_),
+                     max_input_length_(other.max_input_length_),
+                     max_string_length_(other.max_string_length_)
     {
     }
 
@@ -346,6 +352,18 @@ public:
         return lossless_number_;
     }
 
+    // The maximum number of characters of input
+    std::size_t max_input_length() const 
+    {
+        return max_input_length_;
+    }
+
+    // The maximum length in characters of a string or member name, after unescaping
+    std::size_t max_string_length() const 
+    {
+        return max_string_length_;
+    }
+
 #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use lossless_number()")
     bool dec_to_str() const 
@@ -544,6 +562,8 @@ public:
     using basic_json_decode_options<CharT>::neginf_to_num;
 
     using basic_json_decode_options<CharT>::lossless_number;
+    using basic_json_decode_options<CharT>::max_input_length;
+    using basic_json_decode_options<CharT>::max_string_length;
 
     using basic_json_encode_options<CharT>::byte_string_format;
     using basic_json_encode_options<CharT>::bigint_format;
@@ -761,6 +781,18 @@ public:
         return *this;
     }
 
+    basic_json_options& max_input_length(std::size_t value)
+    {
+        this->max_input_length_ = value;
+        return *this;
+    }
+
+    basic_json_options& max_string_length(std::size_t value)
+    {
+        this->max_string_length_ = value;
+        return *this;
+    }
+
 #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use bigint_format(bigint_chars_format)")
     basic_json_options&  big_integer_format(bigint_chars_format value) {this->bigint_format_ = value; return *this;}
@@ -21,6 +21,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -113,6 +114,22 @@ JSONCONS_DEPRECATED_MSG("Instead, use default_json_parsing") typedef default_jso
 JSONCONS_DEPRECATED_MSG("Instead, use strict_json_parsing") typedef strict_json_parsing strict_parse_error_handler;
 #endif
 
+// Selects the compact state mode of basic_json_parser
+struct compact_state_arg_t
+{
+    explicit compact_state_arg_t() = default; 
+};
+
+constexpr compact_state_arg_t compact_state_arg{};
+
+// Selects the validate only mode of basic_json_parser
+struct validate_only_arg_t
+{
+    explicit validate_only_arg_t() = default; 
+};
+
+constexpr validate_only_arg_t validate_only_arg{};
+
 template <class CharT, class TempAllocator = std::allocator<char>>
 class basic_json_parser : public ser_context
 {
@@ -124,9 +141,10 @@ private:
     {
         string_view_type s;
 
-        bool operator()(const std::pair<string_view_type,double>& val) const
+        template <class String>
+        bool operator()(const std::pair<String,double>& val) const
         {
-            return val.first == s;
+            return string_view_type(val.first.data(), val.first.size()) == s;
         }
     };
 
@@ -137,13 +155,16 @@ private:
     static constexpr size_t initial_string_buffer_capacity_ = 1024;
     static constexpr int default_initial_stack_capacity_ = 100;
 
-    basic_json_decode_options<CharT> options_;
-
     std::function<bool(json_errc,const ser_context&)> err_handler_;
+    int max_nesting_depth_;
+    std::size_t max_input_length_;
+    std::size_t max_string_length_;
+    std::size_t input_length_;
     int initial_stack_capacity_;
     int nesting_depth_;
     uint32_t cp_;
     uint32_t cp2_;
+    uint64_t number_value_;
     std::size_t line_;
     std::size_t position_;
     std::size_t mark_position_;
@@ -153,12 +174,18 @@ private:
     json_parse_state state_;
     bool more_;
     bool done_;
+    bool string_non_ascii_;
+    bool number_negative_;
+    bool number_buffered_;
+    bool lossless_number_;
+    bool compact_;
+    bool validate_only_;
 
     std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
     jsoncons::detail::to_double_t to_double_;
 
     std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
-    std::vector<std::pair<string_view_type,double>> string_double_map_;
+    std::vector<std::pair<std::basic_string<CharT>,double>> string_double_map_;
 
     // Noncopyable and nonmoveable
     basic_json_parser(const basic_json_parser&) = delete;
@@ -185,12 +212,48 @@ public:
     basic_json_parser(const basic_json_decode_options<CharT>& options,
                       std::function<bool(json_errc,const ser_context&)> err_handler, 
                       const TempAllocator& alloc = TempAllocator())
-       : options_(options),
-         err_handler_(err_handler),
-         initial_stack_capacity_(default_initial_stack_capacity_),
+       : basic_json_parser(options, err_handler, false, false, alloc)
+    {
+    }
+
+    // Constructs a parser in compact state mode, for keeping many incremental
+    // parsers open at once. Buffers are allocated when first needed rather than
+    // reserved up front, and are released each time a value is complete.
+    basic_json_parser(compact_state_arg_t,
+                      const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                      std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(), 
+                      const TempAllocator& alloc = TempAllocator())
+       : basic_json_parser(options, err_handler, true, false, alloc)
+    {
+    }
+
+    // Constructs a parser in validate only mode, for checking that input is well formed.
+    // The grammar, escapes and UTF-8 are checked exactly as in a full parse, but the
+    // visitor passed to parse_some is not called and numbers are not converted.
+    basic_json_parser(validate_only_arg_t,
+                      const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                      std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(), 
+                      const TempAllocator& alloc = TempAllocator())
+       : basic_json_parser(options, err_handler, false, true, alloc)
+    {
+    }
+
+private:
+    basic_json_parser(const basic_json_decode_options<CharT>& options,
+                      std::function<bool(json_errc,const ser_context&)> err_handler, 
+                      bool compact,
+                      bool validate_only,
+                      const TempAllocator& alloc)
+       : err_handler_(err_handler),
+         max_nesting_depth_(options.max_nesting_depth()),
+         max_input_length_(options.max_input_length()),
+         max_string_length_(options.max_string_length()),
+         input_length_(0),
+         initial_stack_capacity_(compact ? 0 : default_initial_stack_capacity_),
          nesting_depth_(0), 
          cp_(0),
          cp2_(0),
+         number_value_(0),
          line_(1),
          position_(0),
          mark_position_(0),
@@ -200,27 +263,59 @@ public:
          state_(json_parse_state::start),
          more_(true),
          done_(false),
+         string_non_ascii_(false),
+         number_negative_(false),
+         number_buffered_(false),
+         lossless_number_(options.lossless_number()),
+         compact_(compact),
+         validate_only_(validate_only),
          string_buffer_(alloc),
          state_stack_(alloc)
     {
-        string_buffer_.reserve(initial_string_buffer_capacity_);
+        if (!compact_)
+        {
+            string_buffer_.reserve(initial_string_buffer_capacity_);
+        }
 
         state_stack_.reserve(initial_stack_capacity_);
         push_state(json_parse_state::root);
 
-        if (options_.enable_str_to_nan())
+        if (options.enable_str_to_nan())
         {
-            string_double_map_.emplace_back(options_.nan_to_str(),std::nan(""));
+            string_double_map_.emplace_back(options.nan_to_str(),std::nan(""));
         }
-        if (options_.enable_str_to_inf())
+        if (options.enable_str_to_inf())
         {
-            string_double_map_.emplace_back(options_.inf_to_str(),std::numeric_limits<double>::infinity());
+            string_double_map_.emplace_back(options.inf_to_str(),std::numeric_limits<double>::infinity());
         }
-        if (options_.enable_str_to_neginf())
+        if (options.enable_str_to_neginf())
         {
-            string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
+            string_double_map_.emplace_back(options.neginf_to_str(),-std::numeric_limits<double>::infinity());
         }
     }
+public:
+
+    // The approximate number of bytes used by the parser, the parser object and
+    // the buffers it has allocated
+    std::size_t footprint() const
+    {
+        std::size_t size = sizeof(*this) + heap_size(string_buffer_) +
+                           state_stack_.capacity()*sizeof(json_parse_state) +
+                           string_double_map_.capacity()*sizeof(typename decltype(string_double_map_)::value_type);
+        for (const auto& item : string_double_map_)
+        {
+            size += heap_size(item.first);
+        }
+        return size;
+    }
+
+    // Frees the string buffer and the state stack. Only valid between values,
+    // when the parser is done or before the next reset().
+    void release_buffers()
+    {
+        decltype(string_buffer_)(string_buffer_.get_allocator()).swap(string_buffer_);
+        decltype(state_stack_)(state_stack_.get_allocator()).swap(state_stack_);
+    }
 
     bool source_exhausted() const
     {
@@ -261,21 +356,26 @@ public:
             {
                 case ' ':
                 case '\t':
-                    ++input_ptr_;
-                    ++position_;
+                case '\n':
+                {
+                    std::size_t lines = 0;
+                    const CharT* line_start = nullptr;
+                    const CharT* p = jsoncons::detail::skip_whitespace(input_ptr_, local_input_end, lines, line_start);
+                    position_ += (p - input_ptr_);
+                    if (lines > 0)
+                    {
+                        line_ += lines;
+                        mark_position_ = position_ - (p - line_start);
+                    }
+                    input_ptr_ = p;
                     break;
+                }
                 case '\r': 
                     push_state(state_);
                     ++input_ptr_;
                     ++position_;
                     state_ = json_parse_state::cr;
                     return; 
-                case '\n': 
-                    ++input_ptr_;
-                    ++line_;
-                    ++position_;
-                    mark_position_ = position_;
-                    return;   
                 default:
                     return;
             }
@@ -326,7 +426,7 @@ public:
 
     void begin_object(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+        if (JSONCONS_UNLIKELY(++nesting_depth_ > max_nesting_depth_))
         {
             more_ = err_handler_(json_errc::max_nesting_depth_exceeded, *this);
             if (!more_)
@@ -337,7 +437,10 @@ public:
         } 
         push_state(json_parse_state::object);
         state_ = json_parse_state::expect_member_name_or_end;
-        more_ = visitor.begin_object(semantic_tag::none, *this, ec);
+        if (!validate_only_)
+        {
+            more_ = visitor.begin_object(semantic_tag::none, *this, ec);
+        }
     }
 
     void end_object(basic_json_visitor<CharT>& visitor, std::error_code& ec)
@@ -353,7 +456,10 @@ public:
         state_ = pop_state();
         if (state_ == json_parse_state::object)
         {
-            more_ = visitor.end_object(*this, ec);
+            if (!validate_only_)
+            {
+                more_ = visitor.end_object(*this, ec);
+            }
         }
         else if (state_ == json_parse_state::array)
         {
@@ -382,7 +488,7 @@ public:
 
     void begin_array(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        if (++nesting_depth_ > options_.max_nesting_depth())
+        if (++nesting_depth_ > max_nesting_depth_)
         {
             more_ = err_handler_(json_errc::max_nesting_depth_exceeded, *this);
             if (!more_)
@@ -393,7 +499,10 @@ public:
         }
         push_state(json_parse_state::array);
         state_ = json_parse_state::expect_value_or_end;
-        more_ = visitor.begin_array(semantic_tag::none, *this, ec);
+        if (!validate_only_)
+        {
+            more_ = visitor.begin_array(semantic_tag::none, *this, ec);
+        }
     }
 
     void end_array(basic_json_visitor<CharT>& visitor, std::error_code& ec)
@@ -409,7 +518,10 @@ public:
         state_ = pop_state();
         if (state_ == json_parse_state::array)
         {
-            more_ = visitor.end_array(*this, ec);
+            if (!validate_only_)
+            {
+                more_ = visitor.end_array(*this, ec);
+            }
         }
         else if (state_ == json_parse_state::object)
         {
@@ -443,10 +555,13 @@ public:
         state_ = json_parse_state::start;
         more_ = true;
         done_ = false;
+        string_non_ascii_ = false;
         line_ = 1;
         position_ = 0;
         mark_position_ = 0;
         nesting_depth_ = 0;
+        // The unparsed rest of the current input counts towards the next value
+        input_length_ = static_cast<std::size_t>(input_end_ - input_ptr_);
     }
 
     void restart()
@@ -503,6 +618,7 @@ public:
         begin_input_ = data;
         input_end_ = data + length;
         input_ptr_ = begin_input_;
+        input_length_ += length;
     }
 
     void parse_some(basic_json_visitor<CharT>& visitor)
@@ -520,6 +636,42 @@ public:
         parse_some_(visitor, ec);
     }
 
+    // Parses at most max_chars characters of the current buffer and returns the
+    // number parsed. The parser stops where the budget runs out, even within a
+    // string or number, and the next call resumes from there. Reaching the end
+    // of the budget is not the end of the input.
+    std::size_t parse_some(basic_json_visitor<CharT>& visitor, std::size_t max_chars)
+    {
+        std::error_code ec;
+        std::size_t count = parse_some(visitor, max_chars, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column()));
+        }
+        return count;
+    }
+
+    std::size_t parse_some(basic_json_visitor<CharT>& visitor, std::size_t max_chars, std::error_code& ec)
+    {
+        const CharT* start = input_ptr_;
+        if (static_cast<std::size_t>(input_end_ - input_ptr_) > max_chars)
+        {
+            if (max_chars == 0)
+            {
+                return 0;
+            }
+            const CharT* input_end = input_end_;
+            input_end_ = input_ptr_ + max_chars;
+            parse_some_(visitor, ec);
+            input_end_ = input_end;
+        }
+        else
+        {
+            parse_some_(visitor, ec);
+        }
+        return static_cast<std::size_t>(input_ptr_ - start);
+    }
+
     void finish_parse(basic_json_visitor<CharT>& visitor)
     {
         std::error_code ec;
@@ -542,9 +694,13 @@ public:
     {
         if (state_ == json_parse_state::before_done)
         {
-            visitor.flush();
-            done_ = true;
-            state_ = json_parse_state::done;
+            end_root_value(visitor);
+            return;
+        }
+        if (JSONCONS_UNLIKELY(input_length_ > max_input_length_))
+        {
+            err_handler_(json_errc::max_input_length_exceeded, *this);
+            ec = json_errc::max_input_length_exceeded;
             more_ = false;
             return;
         }
@@ -568,10 +724,7 @@ public:
                     if (ec) return;
                     break;
                 case json_parse_state::before_done:
-                    visitor.flush();
-                    done_ = true;
-                    state_ = json_parse_state::done;
-                    more_ = false;
+                    end_root_value(visitor);
                     break;
                 case json_parse_state::done:
                     more_ = false;
@@ -592,10 +745,7 @@ public:
             switch (state_)
             {
                 case json_parse_state::before_done:
-                    visitor.flush();
-                    done_ = true;
-                    state_ = json_parse_state::done;
-                    more_ = false;
+                    end_root_value(visitor);
                     break;
                 case json_parse_state::cr:
                     ++line_;
@@ -630,13 +780,7 @@ public:
                                 ++position_;
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -666,8 +810,7 @@ public:
                                 if (ec) return;
                                 break;
                             case '-':
-                                string_buffer_.clear();
-                                string_buffer_.push_back('-');
+                                begin_number(true, 0);
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::minus;
@@ -675,8 +818,7 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '0': 
-                                string_buffer_.clear();
-                                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                begin_number(false, 0);
                                 state_ = json_parse_state::zero;
                                 ++input_ptr_;
                                 ++position_;
@@ -684,8 +826,7 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                                string_buffer_.clear();
-                                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                begin_number(false, static_cast<uint64_t>(*input_ptr_ - '0'));
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::integer;
@@ -743,13 +884,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/':
@@ -821,13 +956,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/':
@@ -894,13 +1023,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -973,13 +1096,7 @@ public:
                                 ++input_ptr_;
                                 ++position_;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1027,13 +1144,7 @@ public:
                                 ++position_;
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1063,8 +1174,7 @@ public:
                                 if (ec) return;
                                 break;
                             case '-':
-                                string_buffer_.clear();
-                                string_buffer_.push_back('-');
+                                begin_number(true, 0);
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::minus;
@@ -1072,8 +1182,7 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '0': 
-                                string_buffer_.clear();
-                                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                begin_number(false, 0);
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::zero;
@@ -1081,8 +1190,7 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                                string_buffer_.clear();
-                                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                begin_number(false, static_cast<uint64_t>(*input_ptr_ - '0'));
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::integer;
@@ -1168,13 +1276,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1210,8 +1312,7 @@ public:
                                 if (ec) return;
                                 break;
                             case '-':
-                                string_buffer_.clear();
-                                string_buffer_.push_back('-');
+                                begin_number(true, 0);
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::minus;
@@ -1219,8 +1320,7 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '0': 
-                                string_buffer_.clear();
-                                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                begin_number(false, 0);
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::zero;
@@ -1228,8 +1328,7 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                                string_buffer_.clear();
-                                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                begin_number(false, static_cast<uint64_t>(*input_ptr_ - '0'));
                                 ++input_ptr_;
                                 ++position_;
                                 state_ = json_parse_state::integer;
@@ -1331,7 +1430,10 @@ public:
                     switch (*input_ptr_)
                     {
                         case 'e':
-                            more_ = visitor.bool_value(true,  semantic_tag::none, *this, ec);
+                            if (!validate_only_)
+                            {
+                                more_ = visitor.bool_value(true,  semantic_tag::none, *this, ec);
+                            }
                             if (parent() == json_parse_state::root)
                             {
                                 state_ = json_parse_state::before_done;
@@ -1399,7 +1501,10 @@ public:
                     switch (*input_ptr_)
                     {
                         case 'e':
-                            more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                            if (!validate_only_)
+                            {
+                                more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                            }
                             if (parent() == json_parse_state::root)
                             {
                                 state_ = json_parse_state::before_done;
@@ -1452,7 +1557,10 @@ public:
                     switch (*input_ptr_)
                     {
                     case 'l':
-                        more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                        if (!validate_only_)
+                        {
+                            more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                        }
                         if (parent() == json_parse_state::root)
                         {
                             state_ = json_parse_state::before_done;
@@ -1578,7 +1686,10 @@ public:
         {
             if (*(input_ptr_+1) == 'r' && *(input_ptr_+2) == 'u' && *(input_ptr_+3) == 'e')
             {
-                more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
+                if (!validate_only_)
+                {
+                    more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
+                }
                 input_ptr_ += 4;
                 position_ += 4;
                 if (parent() == json_parse_state::root)
@@ -1612,7 +1723,10 @@ public:
         {
             if (*(input_ptr_+1) == 'u' && *(input_ptr_+2) == 'l' && *(input_ptr_+3) == 'l')
             {
-                more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                if (!validate_only_)
+                {
+                    more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                }
                 input_ptr_ += 4;
                 position_ += 4;
                 if (parent() == json_parse_state::root)
@@ -1646,7 +1760,10 @@ public:
         {
             if (*(input_ptr_+1) == 'a' && *(input_ptr_+2) == 'l' && *(input_ptr_+3) == 's' && *(input_ptr_+4) == 'e')
             {
-                more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                if (!validate_only_)
+                {
+                    more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                }
                 input_ptr_ += 5;
                 position_ += 5;
                 if (parent() == json_parse_state::root)
@@ -1708,12 +1825,11 @@ minus_sign:
         switch (*input_ptr_)
         {
             case '0': 
-                string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
                 ++position_;
                 goto zero;
             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_value_ = static_cast<uint64_t>(*input_ptr_ - '0');
                 ++input_ptr_;
                 ++position_;
                 goto integer;
@@ -1771,11 +1887,13 @@ zero:
                 state_ = json_parse_state::expect_comma_or_end;
                 return;
             case '.':
+                buffer_integer();
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
                 ++position_;
                 goto fraction1;
             case 'e':case 'E':
+                buffer_integer();
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
                 ++position_;
@@ -1849,16 +1967,18 @@ integer:
                 state_ = json_parse_state::expect_comma_or_end;
                 return;
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                append_integer_digit(*input_ptr_);
                 ++input_ptr_;
                 ++position_;
                 goto integer;
             case '.':
+                buffer_integer();
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
                 ++position_;
                 goto fraction1;
             case 'e':case 'E':
+                buffer_integer();
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
                 ++position_;
@@ -2127,6 +2247,7 @@ exp3:
         }
 
 string_u1:
+        input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end, string_non_ascii_);
         while (input_ptr_ < local_input_end)
         {
             switch (*input_ptr_)
@@ -2232,6 +2353,12 @@ string_u1:
             string_buffer_.append(sb,input_ptr_-sb);
             position_ += (input_ptr_ - sb + 1);
             state_ = json_parse_state::string;
+            if (JSONCONS_UNLIKELY(string_buffer_.length() > max_string_length_))
+            {
+                err_handler_(json_errc::max_string_length_exceeded, *this);
+                ec = json_errc::max_string_length_exceeded;
+                more_ = false;
+            }
             return;
         }
 
@@ -2371,6 +2498,10 @@ escape_u4:
             }
             else
             {
+                if (cp_ >= 0x80)
+                {
+                    string_non_ascii_ = true;
+                }
                 unicons::convert(&cp_, &cp_ + 1, std::back_inserter(string_buffer_));
                 sb = ++input_ptr_;
                 ++position_;
@@ -2492,6 +2623,7 @@ escape_u9:
                 return;
             }
             uint32_t cp = 0x10000 + ((cp_ & 0x3FF) << 10) + (cp2_ & 0x3FF);
+            string_non_ascii_ = true;
             unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
             sb = ++input_ptr_;
             ++position_;
@@ -2578,6 +2710,7 @@ escape_u9:
         begin_input_ = data;
         input_end_ = data + length;
         input_ptr_ = begin_input_;
+        input_length_ += length;
     }
 #endif
 
@@ -2597,8 +2730,87 @@ escape_u9:
     }
 private:
 
+    void begin_number(bool negative, uint64_t value)
+    {
+        number_negative_ = negative;
+        number_value_ = value;
+        number_buffered_ = false;
+    }
+
+    // Integers are accumulated in number_value_ while scanning, the digits are 
+    // written to string_buffer_ only when a fraction, an exponent or an overflow 
+    // shows up
+    void append_integer_digit(CharT c)
+    {
+        if (JSONCONS_LIKELY(!number_buffered_))
+        {
+            const uint64_t d = static_cast<uint64_t>(c - '0');
+            const uint64_t max_value = (std::numeric_limits<uint64_t>::max)();
+            if (JSONCONS_LIKELY(number_value_ < max_value/10 || (number_value_ == max_value/10 && d <= max_value%10)))
+            {
+                number_value_ = number_value_*10 + d;
+                return;
+            }
+            buffer_integer();
+        }
+        string_buffer_.push_back(static_cast<char>(c));
+    }
+
+    void buffer_integer()
+    {
+        if (number_buffered_)
+        {
+            return;
+        }
+        char buf[24];
+        char* last = buf + sizeof(buf);
+        char* p = last;
+        uint64_t n = number_value_;
+        do
+        {
+            *--p = static_cast<char>('0' + n % 10);
+            n /= 10;
+        }
+        while (n != 0);
+        if (number_negative_)
+        {
+            *--p = '-';
+        }
+        string_buffer_.clear();
+        string_buffer_.append(p, last);
+        number_buffered_ = true;
+    }
+
     void end_integer_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
+        if (validate_only_)
+        {
+            after_value(ec);
+            return;
+        }
+        if (!number_buffered_)
+        {
+            if (!number_negative_)
+            {
+                more_ = visitor.uint64_value(number_value_, semantic_tag::none, *this, ec);
+                after_value(ec);
+                return;
+            }
+            const uint64_t min_magnitude = uint64_t(1) << 63;
+            if (number_value_ < min_magnitude)
+            {
+                more_ = visitor.int64_value(-static_cast<int64_t>(number_value_), semantic_tag::none, *this, ec);
+                after_value(ec);
+                return;
+            }
+            if (number_value_ == min_magnitude)
+            {
+                more_ = visitor.int64_value((std::numeric_limits<int64_t>::min)(), semantic_tag::none, *this, ec);
+                after_value(ec);
+                return;
+            }
+            buffer_integer();
+        }
         if (string_buffer_[0] == '-')
         {
             end_negative_value(visitor, ec);
@@ -2637,11 +2849,40 @@ private:
         after_value(ec);
     }
 
+    void end_root_value(basic_json_visitor<CharT>& visitor)
+    {
+        if (!validate_only_)
+        {
+            visitor.flush();
+        }
+        done_ = true;
+        state_ = json_parse_state::done;
+        more_ = false;
+        if (compact_)
+        {
+            release_buffers();
+        }
+    }
+
+    // The bytes allocated by a string, none if it is held in place
+    template <class String>
+    static std::size_t heap_size(const String& s)
+    {
+        const char* p = reinterpret_cast<const char*>(s.data());
+        const char* first = reinterpret_cast<const char*>(std::addressof(s));
+        return (p >= first && p < first + sizeof(String)) ? 0 : (s.capacity() + 1)*sizeof(typename String::value_type);
+    }
+
     void end_fraction_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
+        if (validate_only_)
+        {
+            after_value(ec);
+            return;
+        }
         JSONCONS_TRY
         {
-            if (options_.lossless_number())
+            if (lossless_number_)
             {
                 more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
             }
@@ -2708,48 +2949,67 @@ private:
         }
     }
 
+    // Reports a string value, or a double if the string is one of the substitutes for NaN or infinity
+    void visit_string_value(const string_view_type& sv, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ sv });
+        if (it != string_double_map_.end())
+        {
+            more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
+        }
+        else
+        {
+            more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+        }
+    }
+
     void end_string_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec) 
     {
-        string_view_type sv(s, length);
-        auto result = unicons::validate(s,s+length);
-        if (result.ec != unicons::conv_errc())
+        if (JSONCONS_UNLIKELY(length > max_string_length_))
         {
-            translate_conv_errc(result.ec,ec);
-            position_ += (result.it - s);
+            err_handler_(json_errc::max_string_length_exceeded, *this);
+            ec = json_errc::max_string_length_exceeded;
+            more_ = false;
             return;
         }
+        string_view_type sv(s, length);
+        // Strings made up of ASCII characters only are valid and are not scanned again
+        if (string_non_ascii_)
+        {
+            string_non_ascii_ = false;
+            auto result = jsoncons::detail::validate_utf(s,s+length);
+            if (result.ec != unicons::conv_errc())
+            {
+                translate_conv_errc(result.ec,ec);
+                position_ += (result.it - s);
+                return;
+            }
+        }
         switch (parent())
         {
         case json_parse_state::member_name:
-            more_ = visitor.key(sv, *this, ec);
+            if (!validate_only_)
+            {
+                more_ = visitor.key(sv, *this, ec);
+            }
             state_ = pop_state();
             state_ = json_parse_state::expect_colon;
             break;
         case json_parse_state::object:
         case json_parse_state::array:
         {
-            auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ sv });
-            if (it != string_double_map_.end())
-            {
-                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
-            }
-            else
+            if (!validate_only_)
             {
-                more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+                visit_string_value(sv, visitor, ec);
             }
             state_ = json_parse_state::expect_comma_or_end;
             break;
         }
         case json_parse_state::root:
         {
-            auto it = std::find_if(string_double_map_.begin(),string_double_map_.end(),string_maps_to_double{sv});
-            if (it != string_double_map_.end())
+            if (!validate_only_)
             {
-                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
-            }
-            else
-            {
-                more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+                visit_string_value(sv, visitor, ec);
             }
             state_ = json_parse_state::before_done;
             break;
@@ -2798,6 +3058,12 @@ private:
             break;
         case json_parse_state::root:
             state_ = json_parse_state::before_done;
+            if (validate_only_)
+            {
+                // Stop at the end of the root value, as a visitor that returns false there
+                // would, so that what follows is checked as basic_json_reader checks it
+                more_ = false;
+            }
             break;
         default:
             more_ = err_handler_(json_errc::invalid_json_text, *this);
@@ -34,8 +34,8 @@ private:
     //std::function<bool(json_errc,const ser_context&)> err_handler_;
 
     // noncopyable and nonmoveable
-    json_utf8_to_other_visitor_adaptor<CharT>(const json_utf8_to_other_visitor_adaptor<CharT>&) = delete;
-    json_utf8_to_other_visitor_adaptor<CharT>& operator=(const json_utf8_to_other_visitor_adaptor<CharT>&) = delete;
+    json_utf8_to_other_visitor_adaptor(const json_utf8_to_other_visitor_adaptor&) = delete;
+    json_utf8_to_other_visitor_adaptor& operator=(const json_utf8_to_other_visitor_adaptor&) = delete;
 
 public:
     json_utf8_to_other_visitor_adaptor()
@@ -480,31 +480,53 @@ public:
 
 private:
 
-    void read_buffer(std::error_code& ec)
+    // Sources that hold their input in memory hand it to the parser in place,
+    // so strings without escapes reach the visitor without being copied
+    template <class S = Src>
+    typename std::enable_if<has_read_buffer<S>::value>::type
+    read_buffer(std::error_code& ec)
+    {
+        auto s = source_.read_buffer();
+        update_parser(s.data(), s.size(), ec);
+    }
+
+    template <class S = Src>
+    typename std::enable_if<!has_read_buffer<S>::value>::type
+    read_buffer(std::error_code& ec)
     {
         buffer_.clear();
         buffer_.resize(buffer_length_);
         std::size_t count = source_.read(buffer_.data(), buffer_length_);
         buffer_.resize(static_cast<std::size_t>(count));
-        if (buffer_.size() == 0)
+        if (source_.is_error())
+        {
+            ec = json_errc::source_error;
+            return;
+        }
+        update_parser(buffer_.data(), buffer_.size(), ec);
+    }
+
+    void update_parser(const CharT* data, std::size_t length, std::error_code& ec)
+    {
+        if (length == 0)
         {
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(data, data+length);
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            std::size_t offset = result.it - buffer_.begin();
-            parser_.update(buffer_.data()+offset,buffer_.size()-offset);
+            std::size_t offset = result.it - data;
+            parser_.update(data+offset,length-offset);
             begin_ = false;
         }
         else
         {
-            parser_.update(buffer_.data(),buffer_.size());
+            parser_.update(data,length);
         }
     }
 };
@@ -0,0 +1,820 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_TAPE_PARSER_HPP
+#define JSONCONS_JSON_TAPE_PARSER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <system_error>
+#include <limits> // std::numeric_limits
+#include <iterator> // std::back_inserter
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+
+// basic_json_tape_parser parses a complete JSON text held in memory in two stages.
+// The first builds an index of the structural characters, a block of 64 characters
+// at a time, and the second walks the index and reports the values to a
+// basic_json_visitor, the same way basic_json_parser does.
+//
+// Input that contains comments is handed to basic_json_parser. When the input is
+// not valid JSON, the error code, line and column are the ones basic_json_reader
+// reports, and the visitor will have received the events that preceded the error.
+// As with basic_json_reader, only whitespace may follow where the visitor stopped.
+
+template <class CharT, class TempAllocator=std::allocator<char>>
+class basic_json_tape_parser : public ser_context
+{
+public:
+    using char_type = CharT;
+    using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+private:
+    using temp_allocator_type = TempAllocator;
+    using char_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT>;
+    using index_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<uint32_t>;
+    using parse_state_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<json_parse_state>;
+
+    static constexpr size_t initial_string_buffer_capacity_ = 1024;
+
+    basic_json_decode_options<CharT> options_;
+    temp_allocator_type alloc_;
+    const CharT* begin_input_;
+    const CharT* end_input_;
+    std::size_t position_;
+    std::size_t error_line_;
+    std::size_t error_column_;
+    bool has_error_position_;
+    bool more_;
+
+    std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
+    jsoncons::detail::to_double_t to_double_;
+
+    std::vector<uint32_t,index_allocator_type> index_;
+    std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
+    std::vector<std::pair<std::basic_string<CharT>,double>> string_double_map_;
+
+    // Noncopyable and nonmoveable
+    basic_json_tape_parser(const basic_json_tape_parser&) = delete;
+    basic_json_tape_parser& operator=(const basic_json_tape_parser&) = delete;
+
+public:
+    basic_json_tape_parser(const TempAllocator& alloc = TempAllocator())
+        : basic_json_tape_parser(basic_json_decode_options<CharT>(), alloc)
+    {
+    }
+
+    basic_json_tape_parser(const basic_json_decode_options<CharT>& options,
+                           const TempAllocator& alloc = TempAllocator())
+       : options_(options),
+         alloc_(alloc),
+         begin_input_(nullptr),
+         end_input_(nullptr),
+         position_(0),
+         error_line_(0),
+         error_column_(0),
+         has_error_position_(false),
+         more_(true),
+         string_buffer_(alloc),
+         index_(alloc),
+         state_stack_(alloc)
+    {
+        string_buffer_.reserve(initial_string_buffer_capacity_);
+
+        if (options_.enable_str_to_nan())
+        {
+            string_double_map_.emplace_back(options_.nan_to_str(),std::nan(""));
+        }
+        if (options_.enable_str_to_inf())
+        {
+            string_double_map_.emplace_back(options_.inf_to_str(),std::numeric_limits<double>::infinity());
+        }
+        if (options_.enable_str_to_neginf())
+        {
+            string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
+        }
+    }
+
+    ~basic_json_tape_parser() noexcept
+    {
+    }
+
+    void parse(const string_view_type& sv, basic_json_visitor<CharT>& visitor)
+    {
+        parse(sv.data(), sv.size(), visitor);
+    }
+
+    void parse(const string_view_type& sv, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        parse(sv.data(), sv.size(), visitor, ec);
+    }
+
+    void parse(const CharT* data, std::size_t length, basic_json_visitor<CharT>& visitor)
+    {
+        std::error_code ec;
+        parse(data, length, visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void parse(const CharT* data, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        begin_input_ = data;
+        end_input_ = data + length;
+        position_ = 0;
+        has_error_position_ = false;
+        more_ = true;
+        index_.clear();
+        state_stack_.clear();
+
+        if (length > (std::numeric_limits<uint32_t>::max)() ||
+            length > options_.max_input_length() ||
+            !jsoncons::detail::build_structural_index(data, length, index_))
+        {
+            parse_with_state_machine(visitor, ec);
+            return;
+        }
+        if (!walk_index(visitor, ec) && !ec)
+        {
+            report_error(ec);
+        }
+    }
+
+    std::size_t line() const override
+    {
+        if (has_error_position_)
+        {
+            return error_line_;
+        }
+        std::size_t line = 1;
+        for (const CharT* p = begin_input_; p != begin_input_ + position_; ++p)
+        {
+            if (*p == '\n')
+            {
+                ++line;
+            }
+        }
+        return line;
+    }
+
+    std::size_t column() const override
+    {
+        if (has_error_position_)
+        {
+            return error_column_;
+        }
+        std::size_t column = 1;
+        for (const CharT* p = begin_input_ + position_; p != begin_input_ && *(p-1) != '\n'; --p)
+        {
+            ++column;
+        }
+        return column;
+    }
+
+    std::size_t position() const override
+    {
+        return position_;
+    }
+
+private:
+
+    void parse_with_state_machine(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        basic_json_parser<CharT,TempAllocator> parser(options_, alloc_);
+        parser.update(begin_input_, end_input_ - begin_input_);
+        parser.finish_parse(visitor, ec);
+        if (!ec)
+        {
+            // As basic_json_reader does, so that an error is reported where it occurs
+            parser.skip_whitespace();
+            parser.check_done(ec);
+        }
+        position_ = parser.position();
+        error_line_ = parser.line();
+        error_column_ = parser.column();
+        has_error_position_ = true;
+    }
+
+    // A visitor that stops at the end of the root value, as json_decoder does
+    class root_stopping_visitor : public basic_default_json_visitor<CharT>
+    {
+        std::size_t depth_;
+    public:
+        root_stopping_visitor()
+            : depth_(0)
+        {
+        }
+    private:
+        bool end_value()
+        {
+            return depth_ != 0;
+        }
+
+        bool visit_begin_object(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            ++depth_;
+            return true;
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            --depth_;
+            return end_value();
+        }
+
+        bool visit_begin_array(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            ++depth_;
+            return true;
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            --depth_;
+            return end_value();
+        }
+
+        bool visit_null(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return end_value();
+        }
+
+        bool visit_string(const string_view_type&, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return end_value();
+        }
+
+        bool visit_bool(bool, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return end_value();
+        }
+
+        bool visit_int64(int64_t, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return end_value();
+        }
+
+        bool visit_uint64(uint64_t, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return end_value();
+        }
+
+        bool visit_double(double, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return end_value();
+        }
+    };
+
+    // The index walk stopped at input that is not valid JSON, basic_json_parser
+    // determines the error and where it occurred. Content after the root value is
+    // reported where basic_json_parser reports it for a visitor that stops there,
+    // if the visitor did.
+    void report_error(std::error_code& ec)
+    {
+        if (more_)
+        {
+            basic_default_json_visitor<CharT> default_visitor;
+            parse_with_state_machine(default_visitor, ec);
+        }
+        else
+        {
+            root_stopping_visitor visitor;
+            parse_with_state_machine(visitor, ec);
+        }
+        if (!ec)
+        {
+            ec = json_errc::invalid_json_text;
+        }
+    }
+
+    // Returns false if the input is not valid JSON, or if the visitor set ec
+    bool walk_index(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const CharT* data = begin_input_;
+        const uint32_t* it = index_.data();
+        const uint32_t* end = it + index_.size();
+        int nesting_depth = 0;
+
+        state_stack_.push_back(json_parse_state::root);
+
+value:
+        if (it == end)
+        {
+            return false;
+        }
+        position_ = *it++;
+        switch (data[position_])
+        {
+            case '{':
+                if (++nesting_depth > options_.max_nesting_depth())
+                {
+                    return false;
+                }
+                more_ = visitor.begin_object(semantic_tag::none, *this, ec);
+                if (ec) {return false;}
+                if (!more_) {return check_rest(ec);}
+                if (it != end && data[*it] == '}')
+                {
+                    position_ = *it++;
+                    --nesting_depth;
+                    more_ = visitor.end_object(*this, ec);
+                    if (ec) {return false;}
+                    goto after_value;
+                }
+                state_stack_.push_back(json_parse_state::object);
+                goto member_name;
+            case '[':
+                if (++nesting_depth > options_.max_nesting_depth())
+                {
+                    return false;
+                }
+                more_ = visitor.begin_array(semantic_tag::none, *this, ec);
+                if (ec) {return false;}
+                if (!more_) {return check_rest(ec);}
+                if (it != end && data[*it] == ']')
+                {
+                    position_ = *it++;
+                    --nesting_depth;
+                    more_ = visitor.end_array(*this, ec);
+                    if (ec) {return false;}
+                    goto after_value;
+                }
+                state_stack_.push_back(json_parse_state::array);
+                goto value;
+            case '\"':
+            {
+                string_view_type sv;
+                if (!parse_string(data + position_ + 1, sv) || sv.size() > options_.max_string_length())
+                {
+                    return false;
+                }
+                string_value(sv, visitor, ec);
+                if (ec) {return false;}
+                goto after_value;
+            }
+            case '}': case ']': case ':': case ',':
+                return false;
+            default:
+                if (!parse_token(data + position_, visitor, ec))
+                {
+                    return false;
+                }
+                goto after_value;
+        }
+
+member_name:
+        if (it == end)
+        {
+            return false;
+        }
+        position_ = *it++;
+        if (data[position_] != '\"')
+        {
+            return false;
+        }
+        {
+            string_view_type sv;
+            if (!parse_string(data + position_ + 1, sv) || sv.size() > options_.max_string_length())
+            {
+                return false;
+            }
+            more_ = visitor.key(sv, *this, ec);
+            if (ec) {return false;}
+        }
+        if (it == end || data[*it] != ':')
+        {
+            return false;
+        }
+        ++it;
+        if (!more_) {return check_rest(ec);}
+        goto value;
+
+after_value:
+        if (state_stack_.back() == json_parse_state::root)
+        {
+            // Anything after the root value is an error, also when the visitor stopped
+            if (it != end)
+            {
+                return false;
+            }
+            visitor.flush();
+            return true;
+        }
+        if (!more_) {return check_rest(ec);}
+        if (it == end)
+        {
+            return false;
+        }
+        position_ = *it++;
+        switch (data[position_])
+        {
+            case ',':
+                if (state_stack_.back() == json_parse_state::object)
+                {
+                    goto member_name;
+                }
+                goto value;
+            case '}':
+                if (state_stack_.back() != json_parse_state::object)
+                {
+                    return false;
+                }
+                state_stack_.pop_back();
+                --nesting_depth;
+                more_ = visitor.end_object(*this, ec);
+                if (ec) {return false;}
+                goto after_value;
+            case ']':
+                if (state_stack_.back() != json_parse_state::array)
+                {
+                    return false;
+                }
+                state_stack_.pop_back();
+                --nesting_depth;
+                more_ = visitor.end_array(*this, ec);
+                if (ec) {return false;}
+                goto after_value;
+            default:
+                return false;
+        }
+    }
+
+    // The visitor stopped inside the root value. As with basic_json_parser::check_done,
+    // only whitespace may follow the input read so far.
+    bool check_rest(std::error_code& ec)
+    {
+        const CharT* p = begin_input_ + position_;
+        switch (*p)
+        {
+            case '\"':
+                ++p;
+                while (p != end_input_ && *p != '\"')
+                {
+                    p += (*p == '\\' && p + 1 != end_input_) ? 2 : 1;
+                }
+                if (p != end_input_)
+                {
+                    ++p;
+                }
+                break;
+            case '{': case '}': case '[': case ']':
+                ++p;
+                break;
+            default:
+            {
+                bool is_number = *p == '-' || (*p >= '0' && *p <= '9');
+                while (p != end_input_ && !is_token_end(*p))
+                {
+                    ++p;
+                }
+                // basic_json_parser reads a comma that ends a number with it
+                if (is_number && p != end_input_ && *p == ',')
+                {
+                    ++p;
+                }
+                break;
+            }
+        }
+        for (; p != end_input_; ++p)
+        {
+            switch (*p)
+            {
+                case ' ': case '\t': case '\n': case '\r':
+                    break;
+                default:
+                    position_ = static_cast<std::size_t>(p - begin_input_);
+                    ec = json_errc::extra_character;
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void string_value(const string_view_type& sv, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        for (const auto& item : string_double_map_)
+        {
+            if (item.first == sv)
+            {
+                more_ = visitor.double_value(item.second, semantic_tag::none, *this, ec);
+                return;
+            }
+        }
+        more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+    }
+
+    // first points to the character after the opening quotation mark. Strings without
+    // escapes are returned in place, others are unescaped into string_buffer_.
+    bool parse_string(const CharT* first, string_view_type& sv)
+    {
+        const CharT* last = end_input_;
+        bool non_ascii = false;
+
+        const CharT* p = jsoncons::detail::find_string_special(first, last, non_ascii);
+        if (p != last && *p == '\"')
+        {
+            sv = string_view_type(first, p - first);
+        }
+        else
+        {
+            string_buffer_.clear();
+            while (true)
+            {
+                if (p == last)
+                {
+                    return false;
+                }
+                if (*p == '\"')
+                {
+                    string_buffer_.append(first, p - first);
+                    break;
+                }
+                if (*p != '\\')
+                {
+                    return false; // control character
+                }
+                string_buffer_.append(first, p - first);
+                if (!unescape(p, non_ascii))
+                {
+                    return false;
+                }
+                first = p;
+                p = jsoncons::detail::find_string_special(first, last, non_ascii);
+            }
+            sv = string_view_type(string_buffer_.data(), string_buffer_.length());
+        }
+        if (non_ascii)
+        {
+            auto result = jsoncons::detail::validate_utf(sv.data(), sv.data() + sv.size());
+            if (result.ec != unicons::conv_errc())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // p points to a reverse solidus, on success it is advanced past the escape sequence
+    bool unescape(const CharT*& p, bool& non_ascii)
+    {
+        const CharT* last = end_input_;
+        if (last - p < 2)
+        {
+            return false;
+        }
+        switch (p[1])
+        {
+            case '\"': string_buffer_.push_back('\"'); break;
+            case '\\': string_buffer_.push_back('\\'); break;
+            case '/': string_buffer_.push_back('/'); break;
+            case 'b': string_buffer_.push_back('\b'); break;
+            case 'f': string_buffer_.push_back('\f'); break;
+            case 'n': string_buffer_.push_back('\n'); break;
+            case 'r': string_buffer_.push_back('\r'); break;
+            case 't': string_buffer_.push_back('\t'); break;
+            case 'u':
+            {
+                uint32_t cp;
+                if (!read_hex4(p + 2, cp))
+                {
+                    return false;
+                }
+                p += 6;
+                if (unicons::is_high_surrogate(cp))
+                {
+                    uint32_t cp2;
+                    if (last - p < 6 || p[0] != '\\' || p[1] != 'u' || !read_hex4(p + 2, cp2))
+                    {
+                        return false;
+                    }
+                    p += 6;
+                    cp = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+                }
+                if (cp >= 0x80)
+                {
+                    non_ascii = true;
+                }
+                unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
+                return true;
+            }
+            default:
+                return false;
+        }
+        p += 2;
+        return true;
+    }
+
+    bool read_hex4(const CharT* p, uint32_t& cp) const
+    {
+        if (end_input_ - p < 4)
+        {
+            return false;
+        }
+        cp = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            CharT c = p[i];
+            cp *= 16;
+            if (c >= '0' && c <= '9')
+            {
+                cp += c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                cp += c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                cp += c - 'A' + 10;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool is_token_end(CharT c)
+    {
+        switch (c)
+        {
+            case ' ': case '\t': case '\n': case '\r':
+            case '{': case '}': case '[': case ']': case ':': case ',': case '\"':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // A literal or a number
+    bool parse_token(const CharT* first, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const CharT* last = first;
+        while (last != end_input_ && !is_token_end(*last))
+        {
+            ++last;
+        }
+        const std::size_t length = last - first;
+
+        switch (*first)
+        {
+            case 't':
+                if (length != 4 || first[1] != 'r' || first[2] != 'u' || first[3] != 'e')
+                {
+                    return false;
+                }
+                more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
+                return !ec;
+            case 'f':
+                if (length != 5 || first[1] != 'a' || first[2] != 'l' || first[3] != 's' || first[4] != 'e')
+                {
+                    return false;
+                }
+                more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                return !ec;
+            case 'n':
+                if (length != 4 || first[1] != 'u' || first[2] != 'l' || first[3] != 'l')
+                {
+                    return false;
+                }
+                more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                return !ec;
+            default:
+                return parse_number(first, last, visitor, ec);
+        }
+    }
+
+    bool parse_number(const CharT* first, const CharT* last, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const CharT* p = first;
+        const bool negative = *p == '-';
+        if (negative)
+        {
+            ++p;
+        }
+        if (p == last || !(*p >= '0' && *p <= '9'))
+        {
+            return false;
+        }
+
+        uint64_t value = 0;
+        bool overflow = false;
+        if (*p == '0')
+        {
+            ++p;
+        }
+        else
+        {
+            const uint64_t max_value = (std::numeric_limits<uint64_t>::max)();
+            for (; p != last && *p >= '0' && *p <= '9'; ++p)
+            {
+                const uint64_t d = static_cast<uint64_t>(*p - '0');
+                if (value < max_value/10 || (value == max_value/10 && d <= max_value%10))
+                {
+                    value = value*10 + d;
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
+        }
+
+        bool is_fraction = false;
+        if (p != last && *p == '.')
+        {
+            is_fraction = true;
+            ++p;
+            if (p == last || !(*p >= '0' && *p <= '9'))
+            {
+                return false;
+            }
+            while (p != last && *p >= '0' && *p <= '9')
+            {
+                ++p;
+            }
+        }
+        if (p != last && (*p == 'e' || *p == 'E'))
+        {
+            is_fraction = true;
+            ++p;
+            if (p != last && (*p == '+' || *p == '-'))
+            {
+                ++p;
+            }
+            if (p == last || !(*p >= '0' && *p <= '9'))
+            {
+                return false;
+            }
+            while (p != last && *p >= '0' && *p <= '9')
+            {
+                ++p;
+            }
+        }
+        if (p != last)
+        {
+            return false;
+        }
+
+        if (is_fraction)
+        {
+            // Same text as basic_json_parser buffers, with the locale's decimal point
+            string_buffer_.clear();
+            for (p = first; p != last; ++p)
+            {
+                string_buffer_.push_back(*p == '.' ? static_cast<CharT>(to_double_.get_decimal_point()) : *p);
+            }
+            if (options_.lossless_number())
+            {
+                more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
+                return !ec;
+            }
+            JSONCONS_TRY
+            {
+                double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
+            }
+            JSONCONS_CATCH(...)
+            {
+                return false;
+            }
+            return !ec;
+        }
+
+        if (!negative && !overflow)
+        {
+            more_ = visitor.uint64_value(value, semantic_tag::none, *this, ec);
+        }
+        else if (negative && !overflow && value <= (uint64_t(1) << 63))
+        {
+            int64_t n = value == (uint64_t(1) << 63) ? (std::numeric_limits<int64_t>::min)() : -static_cast<int64_t>(value);
+            more_ = visitor.int64_value(n, semantic_tag::none, *this, ec);
+        }
+        else
+        {
+            more_ = visitor.string_value(string_view_type(first, last - first), semantic_tag::bigint, *this, ec);
+        }
+        return !ec;
+    }
+};
+
+using json_tape_parser = basic_json_tape_parser<char>;
+using wjson_tape_parser = basic_json_tape_parser<wchar_t>;
+
+}
+
+#endif
+
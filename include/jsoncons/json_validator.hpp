@@ -0,0 +1,316 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_VALIDATOR_HPP
+#define JSONCONS_JSON_VALIDATOR_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/source.hpp>
+
+namespace jsoncons {
+
+// basic_json_validator checks that its input is a single well formed JSON text,
+// accepting and rejecting exactly what basic_json_reader does with the same
+// options and error handler. The parser runs in validate only mode, no values
+// are reported and numbers are not converted. On failure, line(), column()
+// and position() give the location of the first error.
+
+template<class CharT,class Src=jsoncons::stream_source<CharT>,class Allocator=std::allocator<char>>
+class basic_json_validator
+{
+public:
+    using char_type = CharT;
+    using source_type = Src;
+    using string_view_type = basic_string_view<CharT>;
+    using temp_allocator_type = Allocator;
+private:
+    typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
+
+    static constexpr size_t default_max_buffer_length = 16384;
+
+    // Never called in validate only mode
+    basic_default_json_visitor<CharT> visitor_;
+
+    basic_json_parser<CharT,Allocator> parser_;
+
+    source_type source_;
+    bool eof_;
+    bool begin_;
+    std::size_t buffer_length_;
+    std::vector<CharT,char_allocator_type> buffer_;
+
+    // Noncopyable and nonmoveable
+    basic_json_validator(const basic_json_validator&) = delete;
+    basic_json_validator& operator=(const basic_json_validator&) = delete;
+
+public:
+    template <class Source>
+    explicit basic_json_validator(Source&& source, const Allocator& alloc = Allocator())
+        : basic_json_validator(std::forward<Source>(source),
+                               basic_json_decode_options<CharT>(),
+                               default_json_parsing(),
+                               alloc)
+    {
+    }
+
+    template <class Source>
+    basic_json_validator(Source&& source,
+                         const basic_json_decode_options<CharT>& options,
+                         const Allocator& alloc = Allocator())
+        : basic_json_validator(std::forward<Source>(source),
+                               options,
+                               default_json_parsing(),
+                               alloc)
+    {
+    }
+
+    template <class Source>
+    basic_json_validator(Source&& source,
+                         std::function<bool(json_errc,const ser_context&)> err_handler,
+                         const Allocator& alloc = Allocator())
+        : basic_json_validator(std::forward<Source>(source),
+                               basic_json_decode_options<CharT>(),
+                               err_handler,
+                               alloc)
+    {
+    }
+
+    template <class Source>
+    basic_json_validator(Source&& source,
+                         const basic_json_decode_options<CharT>& options,
+                         std::function<bool(json_errc,const ser_context&)> err_handler,
+                         const Allocator& alloc = Allocator(),
+                         typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
+       : parser_(validate_only_arg, options, err_handler, alloc),
+         source_(std::forward<Source>(source)),
+         eof_(false),
+         begin_(true),
+         buffer_length_(default_max_buffer_length),
+         buffer_(alloc)
+    {
+        buffer_.reserve(buffer_length_);
+    }
+
+    template <class Source>
+    basic_json_validator(Source&& source,
+                         const basic_json_decode_options<CharT>& options,
+                         std::function<bool(json_errc,const ser_context&)> err_handler,
+                         const Allocator& alloc = Allocator(),
+                         typename std::enable_if<std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
+       : parser_(validate_only_arg, options, err_handler, alloc),
+         eof_(false),
+         begin_(false),
+         buffer_length_(0),
+         buffer_(alloc)
+    {
+        basic_string_view<CharT> sv(std::forward<Source>(source));
+        auto result = unicons::skip_bom(sv.begin(), sv.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            JSONCONS_THROW(ser_error(result.ec,parser_.line(),parser_.column()));
+        }
+        std::size_t offset = result.it - sv.begin();
+        parser_.update(sv.data()+offset,sv.size()-offset);
+    }
+
+    std::size_t buffer_length() const
+    {
+        return buffer_length_;
+    }
+
+    void buffer_length(std::size_t length)
+    {
+        buffer_length_ = length;
+        buffer_.reserve(buffer_length_);
+    }
+
+    std::size_t line() const
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const
+    {
+        return parser_.column();
+    }
+
+    std::size_t position() const
+    {
+        return parser_.position();
+    }
+
+    void validate()
+    {
+        std::error_code ec;
+        validate(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void validate(std::error_code& ec)
+    {
+        if (source_.is_error())
+        {
+            ec = json_errc::source_error;
+            return;
+        }
+        parser_.reset();
+        while (!parser_.finished())
+        {
+            if (parser_.source_exhausted())
+            {
+                if (!source_.eof())
+                {
+                    read_buffer(ec);
+                    if (ec) return;
+                }
+                else
+                {
+                    eof_ = true;
+                }
+            }
+            parser_.parse_some(visitor_, ec);
+            if (ec) return;
+        }
+        check_done(ec);
+    }
+
+    // Returns true if the input is well formed, the location of the first error is
+    // available from line(), column() and position() otherwise
+    bool is_valid()
+    {
+        std::error_code ec;
+        validate(ec);
+        return !ec;
+    }
+
+private:
+
+    // As basic_json_reader::read_next followed by basic_json_reader::check_done
+    void check_done(std::error_code& ec)
+    {
+        while (!eof_)
+        {
+            parser_.skip_whitespace();
+            if (parser_.source_exhausted())
+            {
+                if (!source_.eof())
+                {
+                    read_buffer(ec);
+                    if (ec) return;
+                }
+                else
+                {
+                    eof_ = true;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (source_.is_error())
+        {
+            ec = json_errc::source_error;
+            return;
+        }   
+        if (eof_)
+        {
+            parser_.check_done(ec);
+            if (ec) return;
+        }
+        else
+        {
+            while (!eof_)
+            {
+                if (parser_.source_exhausted())
+                {
+                    if (!source_.eof())
+                    {
+                        read_buffer(ec);     
+                        if (ec) return;
+                    }
+                    else
+                    {
+                        eof_ = true;
+                    }
+                }
+                if (!eof_)
+                {
+                    parser_.check_done(ec);
+                    if (ec) return;
+                }
+            }
+        }
+    }
+
+    template <class S = Src>
+    typename std::enable_if<has_read_buffer<S>::value>::type
+    read_buffer(std::error_code& ec)
+    {
+        auto s = source_.read_buffer();
+        update_parser(s.data(), s.size(), ec);
+    }
+
+    template <class S = Src>
+    typename std::enable_if<!has_read_buffer<S>::value>::type
+    read_buffer(std::error_code& ec)
+    {
+        buffer_.clear();
+        buffer_.resize(buffer_length_);
+        std::size_t count = source_.read(buffer_.data(), buffer_length_);
+        buffer_.resize(static_cast<std::size_t>(count));
+        if (source_.is_error())
+        {
+            ec = json_errc::source_error;
+            return;
+        }
+        update_parser(buffer_.data(), buffer_.size(), ec);
+    }
+
+    void update_parser(const CharT* data, std::size_t length, std::error_code& ec)
+    {
+        if (length == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(data, data+length);
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - data;
+            parser_.update(data+offset,length-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(data,length);
+        }
+    }
+};
+
+using json_validator = basic_json_validator<char>;
+using wjson_validator = basic_json_validator<wchar_t>;
+
+}
+
+#endif
+
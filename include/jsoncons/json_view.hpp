@@ -0,0 +1,602 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_VIEW_HPP
+#define JSONCONS_JSON_VIEW_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <iterator>
+#include <system_error>
+#include <limits> // std::numeric_limits
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_tape_parser.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+
+// basic_json_index holds a pointer to a JSON text and an index of its structural
+// characters, and hands out basic_json_view values that navigate the text lazily.
+// Only the values that are converted with as<T>() are parsed, with
+// basic_json_tape_parser, so the results are the same as basic_json::parse.
+//
+// The text must outlive the index and its views. An index is not modified after it
+// is built, so its views may be used from several threads. Brackets and braces are
+// matched when the index is built, other errors are reported when the value that
+// contains them is accessed. Texts with comments are not supported.
+
+template <class CharT, class TempAllocator=std::allocator<char>>
+class basic_json_index;
+
+template <class CharT, class TempAllocator=std::allocator<char>>
+class basic_json_view;
+
+template <class CharT, class TempAllocator>
+class basic_json_index
+{
+    friend class basic_json_view<CharT,TempAllocator>;
+public:
+    using char_type = CharT;
+    using string_view_type = jsoncons::basic_string_view<CharT>;
+    using view_type = basic_json_view<CharT,TempAllocator>;
+private:
+    using temp_allocator_type = TempAllocator;
+    using index_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<uint32_t>;
+
+    const CharT* data_;
+    std::size_t length_;
+    basic_json_decode_options<CharT> options_;
+    temp_allocator_type alloc_;
+    std::vector<uint32_t,index_allocator_type> positions_;
+    // For an entry that opens an object or array, the entry that closes it
+    std::vector<uint32_t,index_allocator_type> ends_;
+
+    // Noncopyable and nonmoveable, views point to the index
+    basic_json_index(const basic_json_index&) = delete;
+    basic_json_index& operator=(const basic_json_index&) = delete;
+public:
+    basic_json_index(const string_view_type& sv,
+                     const TempAllocator& alloc = TempAllocator())
+        : basic_json_index(sv, basic_json_decode_options<CharT>(), alloc)
+    {
+    }
+
+    basic_json_index(const string_view_type& sv,
+                     const basic_json_decode_options<CharT>& options,
+                     const TempAllocator& alloc = TempAllocator())
+        : data_(sv.data()), length_(sv.size()), options_(options), alloc_(alloc),
+          positions_(alloc), ends_(alloc)
+    {
+        if (length_ > (std::numeric_limits<uint32_t>::max)())
+        {
+            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Text too long to index"));
+        }
+        if (!jsoncons::detail::build_structural_index(data_, length_, positions_))
+        {
+            JSONCONS_THROW(ser_error(json_errc::illegal_comment));
+        }
+        match_brackets();
+    }
+
+    view_type root() const
+    {
+        return view_type(this, 0);
+    }
+
+    string_view_type text() const
+    {
+        return string_view_type(data_, length_);
+    }
+
+private:
+
+    void match_brackets()
+    {
+        ends_.resize(positions_.size());
+        std::vector<uint32_t,index_allocator_type> stack(alloc_);
+        for (std::size_t i = 0; i < positions_.size(); ++i)
+        {
+            switch (data_[positions_[i]])
+            {
+                case '{':
+                case '[':
+                    stack.push_back(static_cast<uint32_t>(i));
+                    break;
+                case '}':
+                case ']':
+                    if (stack.empty() || data_[positions_[stack.back()]] != (data_[positions_[i]] == '}' ? '{' : '['))
+                    {
+                        report_error();
+                    }
+                    ends_[stack.back()] = static_cast<uint32_t>(i);
+                    stack.pop_back();
+                    break;
+                default:
+                    break;
+            }
+        }
+        // A single value with no unmatched brackets
+        if (!stack.empty() || positions_.empty() || end_of(0) + 1 != positions_.size())
+        {
+            report_error();
+        }
+    }
+
+    // Parses the whole text to find the error and where it occurred
+    void report_error() const
+    {
+        basic_json_tape_parser<CharT,TempAllocator> parser(options_, alloc_);
+        basic_default_json_visitor<CharT> visitor;
+        std::error_code ec;
+        parser.parse(data_, length_, visitor, ec);
+        JSONCONS_THROW(ser_error(ec ? ec : json_errc::invalid_json_text, parser.line(), parser.column()));
+    }
+
+    CharT char_at(std::size_t entry) const
+    {
+        return data_[positions_[entry]];
+    }
+
+    // The last entry of the value that starts at entry
+    std::size_t end_of(std::size_t entry) const
+    {
+        switch (char_at(entry))
+        {
+            case '{':
+            case '[':
+                return ends_[entry];
+            default:
+                return entry;
+        }
+    }
+
+    void expect(std::size_t entry, CharT c) const
+    {
+        if (entry >= positions_.size() || char_at(entry) != c)
+        {
+            report_error();
+        }
+    }
+
+    // Parses the value that starts at entry, with a parser of its own so that views
+    // of the same index can be read from several threads
+    void parse(std::size_t entry, basic_json_visitor<CharT>& visitor) const
+    {
+        basic_json_tape_parser<CharT,TempAllocator> parser(options_, alloc_);
+        parse(entry, visitor, parser);
+    }
+
+    void parse(std::size_t entry, basic_json_visitor<CharT>& visitor, basic_json_tape_parser<CharT,TempAllocator>& parser) const
+    {
+        std::size_t first = positions_[entry];
+        std::size_t next = end_of(entry) + 1;
+        std::size_t last = next < positions_.size() ? positions_[next] : length_;
+
+        std::error_code ec;
+        parser.parse(data_ + first, last - first, visitor, ec);
+        if (ec)
+        {
+            // Line and column relative to the whole text
+            std::size_t line = 1;
+            std::size_t line_start = 0;
+            for (std::size_t i = 0; i < first; ++i)
+            {
+                if (data_[i] == '\n')
+                {
+                    ++line;
+                    line_start = i + 1;
+                }
+            }
+            std::size_t column = parser.line() == 1 ? (first - line_start) + parser.column() : parser.column();
+            JSONCONS_THROW(ser_error(ec, line + parser.line() - 1, column));
+        }
+    }
+
+    // Compares the key at entry with name
+    bool key_equals(std::size_t entry, const string_view_type& name) const
+    {
+        const CharT* first = data_ + positions_[entry] + 1;
+        bool non_ascii = false;
+        const CharT* p = jsoncons::detail::find_string_special(first, data_ + length_, non_ascii);
+        if (p != data_ + length_ && *p == '\"' && !non_ascii)
+        {
+            return string_view_type(first, p - first) == name;
+        }
+        return key(entry) == name;
+    }
+
+    // Unescapes and validates the key at entry
+    std::basic_string<CharT> key(std::size_t entry) const
+    {
+        struct key_visitor : public basic_default_json_visitor<CharT>
+        {
+            std::basic_string<CharT> key;
+
+            bool visit_string(const string_view_type& s, semantic_tag, const ser_context&, std::error_code&) override
+            {
+                key.assign(s.data(), s.size());
+                return true;
+            }
+        };
+
+        // Default options, a key is never replaced by a number
+        basic_json_tape_parser<CharT,TempAllocator> parser(alloc_);
+        key_visitor visitor;
+        parse(entry, visitor, parser);
+        return visitor.key;
+    }
+};
+
+template <class CharT, class TempAllocator>
+class basic_json_view
+{
+    friend class basic_json_index<CharT,TempAllocator>;
+public:
+    using char_type = CharT;
+    using string_view_type = jsoncons::basic_string_view<CharT>;
+    using index_type = basic_json_index<CharT,TempAllocator>;
+
+    class key_value_view
+    {
+        const index_type* index_;
+        std::size_t entry_;
+    public:
+        key_value_view(const index_type* index, std::size_t entry)
+            : index_(index), entry_(entry)
+        {
+        }
+
+        std::basic_string<CharT> key() const
+        {
+            return index_->key(entry_);
+        }
+
+        basic_json_view value() const
+        {
+            return basic_json_view(index_, entry_ + 2);
+        }
+    };
+
+    class array_iterator
+    {
+        const index_type* index_;
+        std::size_t entry_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = basic_json_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const basic_json_view*;
+        using reference = basic_json_view;
+
+        array_iterator()
+            : index_(nullptr), entry_(0)
+        {
+        }
+
+        array_iterator(const index_type* index, std::size_t entry)
+            : index_(index), entry_(entry)
+        {
+        }
+
+        basic_json_view operator*() const
+        {
+            return basic_json_view(index_, entry_);
+        }
+
+        array_iterator& operator++()
+        {
+            entry_ = basic_json_view::next_element(index_, entry_);
+            return *this;
+        }
+
+        array_iterator operator++(int)
+        {
+            array_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        friend bool operator==(const array_iterator& lhs, const array_iterator& rhs)
+        {
+            return lhs.entry_ == rhs.entry_;
+        }
+
+        friend bool operator!=(const array_iterator& lhs, const array_iterator& rhs)
+        {
+            return lhs.entry_ != rhs.entry_;
+        }
+    };
+
+    class object_iterator
+    {
+        const index_type* index_;
+        std::size_t entry_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = key_value_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const key_value_view*;
+        using reference = key_value_view;
+
+        object_iterator()
+            : index_(nullptr), entry_(0)
+        {
+        }
+
+        object_iterator(const index_type* index, std::size_t entry)
+            : index_(index), entry_(entry)
+        {
+        }
+
+        key_value_view operator*() const
+        {
+            return key_value_view(index_, entry_);
+        }
+
+        object_iterator& operator++()
+        {
+            entry_ = basic_json_view::next_member(index_, entry_);
+            return *this;
+        }
+
+        object_iterator operator++(int)
+        {
+            object_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        friend bool operator==(const object_iterator& lhs, const object_iterator& rhs)
+        {
+            return lhs.entry_ == rhs.entry_;
+        }
+
+        friend bool operator!=(const object_iterator& lhs, const object_iterator& rhs)
+        {
+            return lhs.entry_ != rhs.entry_;
+        }
+    };
+
+private:
+    const index_type* index_;
+    std::size_t entry_;
+
+    basic_json_view(const index_type* index, std::size_t entry)
+        : index_(index), entry_(entry)
+    {
+    }
+
+    // The entry of the element that follows the one at entry, or of the closing bracket
+    static std::size_t next_element(const index_type* index, std::size_t entry)
+    {
+        std::size_t next = index->end_of(entry) + 1;
+        if (next < index->positions_.size() && index->char_at(next) == ',')
+        {
+            return next + 1;
+        }
+        index->expect(next, ']');
+        return next;
+    }
+
+    // The entry of the key of the member that follows the one whose key is at entry,
+    // or of the closing brace
+    static std::size_t next_member(const index_type* index, std::size_t entry)
+    {
+        index->expect(entry, '\"');
+        index->expect(entry + 1, ':');
+        std::size_t next = index->end_of(entry + 2) + 1;
+        if (next < index->positions_.size() && index->char_at(next) == ',')
+        {
+            index->expect(next + 1, '\"');
+            return next + 1;
+        }
+        index->expect(next, '}');
+        return next;
+    }
+
+    std::size_t first_child() const
+    {
+        return entry_ + 1;
+    }
+
+    std::size_t end_child() const
+    {
+        return index_->ends_[entry_];
+    }
+
+public:
+    bool is_object() const
+    {
+        return index_->char_at(entry_) == '{';
+    }
+
+    bool is_array() const
+    {
+        return index_->char_at(entry_) == '[';
+    }
+
+    bool is_string() const
+    {
+        return index_->char_at(entry_) == '\"';
+    }
+
+    bool is_null() const
+    {
+        return index_->char_at(entry_) == 'n';
+    }
+
+    bool is_bool() const
+    {
+        CharT c = index_->char_at(entry_);
+        return c == 't' || c == 'f';
+    }
+
+    bool is_number() const
+    {
+        CharT c = index_->char_at(entry_);
+        return c == '-' || (c >= '0' && c <= '9');
+    }
+
+    // The text of the value
+    string_view_type raw() const
+    {
+        std::size_t last = index_->end_of(entry_);
+        std::size_t first_position = index_->positions_[entry_];
+        std::size_t last_position;
+        if (last != entry_ || is_object() || is_array())
+        {
+            last_position = index_->positions_[last] + 1;
+        }
+        else
+        {
+            // A string or other token, trailing whitespace is not part of the value
+            last_position = last + 1 < index_->positions_.size() ? index_->positions_[last + 1] : index_->length_;
+            while (last_position > first_position)
+            {
+                CharT c = index_->data_[last_position - 1];
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+                {
+                    break;
+                }
+                --last_position;
+            }
+        }
+        return string_view_type(index_->data_ + first_position, last_position - first_position);
+    }
+
+    std::size_t size() const
+    {
+        std::size_t count = 0;
+        if (is_array())
+        {
+            for (std::size_t entry = first_child(); entry != end_child(); entry = next_element(index_, entry))
+            {
+                ++count;
+            }
+        }
+        else if (is_object())
+        {
+            for (std::size_t entry = first_child(); entry != end_child(); entry = next_member(index_, entry))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    bool empty() const
+    {
+        return (is_array() || is_object()) && first_child() == end_child();
+    }
+
+    bool contains(const string_view_type& name) const
+    {
+        if (!is_object())
+        {
+            return false;
+        }
+        for (std::size_t entry = first_child(); entry != end_child(); entry = next_member(index_, entry))
+        {
+            if (index_->key_equals(entry, name))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    basic_json_view at(const string_view_type& name) const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(not_an_object(name.data(),name.length()));
+        }
+        for (std::size_t entry = first_child(); entry != end_child(); entry = next_member(index_, entry))
+        {
+            if (index_->key_equals(entry, name))
+            {
+                index_->expect(entry + 1, ':');
+                return basic_json_view(index_, entry + 2);
+            }
+        }
+        JSONCONS_THROW(key_not_found(name.data(),name.length()));
+    }
+
+    basic_json_view operator[](const string_view_type& name) const
+    {
+        return at(name);
+    }
+
+    basic_json_view at(std::size_t i) const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+        }
+        for (std::size_t entry = first_child(); entry != end_child(); entry = next_element(index_, entry))
+        {
+            if (i-- == 0)
+            {
+                return basic_json_view(index_, entry);
+            }
+        }
+        JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+    }
+
+    basic_json_view operator[](std::size_t i) const
+    {
+        return at(i);
+    }
+
+    range<array_iterator,array_iterator> array_range() const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+        }
+        return range<array_iterator,array_iterator>(array_iterator(index_, first_child()),
+                                                    array_iterator(index_, end_child()));
+    }
+
+    range<object_iterator,object_iterator> object_range() const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+        }
+        return range<object_iterator,object_iterator>(object_iterator(index_, first_child()),
+                                                      object_iterator(index_, end_child()));
+    }
+
+    template <class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    as() const
+    {
+        json_decoder<T> decoder;
+        index_->parse(entry_, decoder);
+        return decoder.get_result();
+    }
+
+    template <class T>
+    typename std::enable_if<!is_basic_json<T>::value,T>::type
+    as() const
+    {
+        return as<basic_json<CharT>>().template as<T>();
+    }
+};
+
+using json_index = basic_json_index<char>;
+using wjson_index = basic_json_index<wchar_t>;
+using json_view = basic_json_view<char>;
+using wjson_view = basic_json_view<wchar_t>;
+
+}
+
+#endif
+
@@ -0,0 +1,226 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+// mmap_source and binary_mmap_source are available where JSONCONS_HAS_MMAP is
+// defined, on POSIX and Windows. They are kept out of source.hpp so that only
+// the users of them include the platform headers for mapping files.
+
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <string>
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/detail/span.hpp>
+#include <jsoncons/detail/mapped_file.hpp>
+
+#if defined(JSONCONS_HAS_MMAP)
+
+namespace jsoncons {
+
+    // mmap_source
+
+    // Maps a whole file into memory and hands it to the parser in place. If the file
+    // cannot be opened or mapped, is_error() is true.
+    template <class CharT>
+    class mmap_source 
+    {
+    public:
+        using value_type = CharT;
+    private:
+        jsoncons::detail::mapped_file file_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable 
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+    public:
+        mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        mmap_source(const std::string& path)
+            : file_(path), 
+              data_(reinterpret_cast<const value_type*>(file_.data())), 
+              current_(data_), 
+              end_(data_ + file_.size()/sizeof(value_type))
+        {
+        }
+
+        mmap_source(mmap_source&& other) 
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+            swap(other);
+        }
+
+        mmap_source& operator=(mmap_source&& other)
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(mmap_source& other)
+        {
+            file_.swap(other.file_);
+            std::swap(data_,other.data_);
+            std::swap(current_,other.current_);
+            std::swap(end_,other.end_);
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;  
+        }
+
+        bool is_error() const
+        {
+            return !file_.is_open();  
+        }
+
+        std::size_t position() const
+        {
+            return (current_ - data_) + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_++) : character_result<value_type>();
+        }
+
+        void ignore(std::size_t count)
+        {
+            current_ += (std::min)(count, static_cast<std::size_t>(end_ - current_));
+        }
+
+        character_result<value_type> peek_character() 
+        {
+            return current_ < end_ ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(end_ - current_));
+            std::memcpy(p, current_, len*sizeof(value_type));
+            current_  += len;
+            return len;
+        }
+
+        // Returns the remaining characters in place, without copying them
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            jsoncons::detail::span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
+    };
+
+    // binary_mmap_source
+
+    // Maps a whole file into memory, reads copy straight from the mapping. If the file
+    // cannot be opened or mapped, is_error() is true.
+    class binary_mmap_source 
+    {
+    public:
+        typedef uint8_t value_type;
+    private:
+        jsoncons::detail::mapped_file file_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable 
+        binary_mmap_source(const binary_mmap_source&) = delete;
+        binary_mmap_source& operator=(const binary_mmap_source&) = delete;
+    public:
+        binary_mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        binary_mmap_source(const std::string& path)
+            : file_(path), data_(file_.data()), current_(data_), end_(data_ + file_.size())
+        {
+        }
+
+        binary_mmap_source(binary_mmap_source&& other) 
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+            swap(other);
+        }
+
+        binary_mmap_source& operator=(binary_mmap_source&& other)
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(binary_mmap_source& other)
+        {
+            file_.swap(other.file_);
+            std::swap(data_,other.data_);
+            std::swap(current_,other.current_);
+            std::swap(end_,other.end_);
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;  
+        }
+
+        bool is_error() const
+        {
+            return !file_.is_open();  
+        }
+
+        std::size_t position() const
+        {
+            return current_ - data_ + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_++) : character_result<value_type>();
+        }
+
+        void ignore(std::size_t count)
+        {
+            current_ += (std::min)(count, static_cast<std::size_t>(end_ - current_));
+        }
+
+        character_result<value_type> peek_character() 
+        {
+            return current_ < end_ ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(end_ - current_));
+            std::memcpy(p, current_, len);
+            current_  += len;
+            return len;
+        }
+
+        // Returns the next length bytes in place, or fewer if the file ends first
+        jsoncons::detail::span<const value_type> read_view(std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(end_ - current_));
+            jsoncons::detail::span<const value_type> s(current_, len);
+            current_ += len;
+            return s;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif // defined(JSONCONS_HAS_MMAP)
+
+#endif
@@ -0,0 +1,301 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PREFETCH_SOURCE_HPP
+#define JSONCONS_PREFETCH_SOURCE_HPP
+
+#include <cstddef>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <memory> // std::unique_ptr
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits> // std::enable_if
+#include <utility> // std::forward
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/detail/span.hpp>
+
+namespace jsoncons {
+
+    // prefetch_source
+
+    // Reads ahead from another source, such as stream_source or binary_stream_source,
+    // on a helper thread, so that reading the next block overlaps with parsing the
+    // current one. The wrapped source is constructed in place and used only by the
+    // helper thread.
+    //
+    // The helper thread is stopped and joined when the prefetch_source is destroyed,
+    // whether the input was read to the end, a parse error occurred, or the reader
+    // stopped early. Destruction waits for a read in progress to return. Blocks that
+    // were read ahead but not consumed are discarded.
+    template <class Source>
+    class prefetch_source
+    {
+    public:
+        using value_type = typename Source::value_type;
+        static constexpr std::size_t default_block_size = 16384;
+    private:
+        // Shared between the reading and the helper thread
+        struct shared_state
+        {
+            Source source;
+            std::size_t block_size;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::vector<value_type> next;  // a block handed over to the reading thread
+            bool next_ready;
+            bool done;                     // the helper thread has read its last block
+            bool error;
+            bool stop;
+
+            template <class Sourceable>
+            shared_state(Sourceable&& s, std::size_t size)
+                : source(std::forward<Sourceable>(s)), block_size(size),
+                  next_ready(false), done(false), error(false), stop(false)
+            {
+            }
+        };
+
+        std::unique_ptr<shared_state> state_;
+        std::thread thread_;
+        std::vector<value_type> current_;  // the block being consumed
+        std::size_t offset_;               // next unread value in current_
+        std::size_t position_;
+        bool exhausted_;                   // no more blocks will arrive
+        bool error_;
+        std::vector<value_type> view_buffer_;
+
+        // Noncopyable
+        prefetch_source(const prefetch_source&) = delete;
+        prefetch_source& operator=(const prefetch_source&) = delete;
+    public:
+        prefetch_source()
+            : offset_(0), position_(0), exhausted_(true), error_(false)
+        {
+        }
+
+        template <class Sourceable>
+        prefetch_source(Sourceable&& source,
+                        std::size_t block_size = default_block_size,
+                        typename std::enable_if<std::is_constructible<Source,Sourceable>::value>::type* = 0)
+            : state_(new shared_state(std::forward<Sourceable>(source), block_size > 0 ? block_size : 1)),
+              offset_(0), position_(0), exhausted_(false), error_(false)
+        {
+            shared_state* state = state_.get();
+            thread_ = std::thread([state]() {read_ahead(*state);});
+        }
+
+        prefetch_source(prefetch_source&& other) noexcept
+            : offset_(0), position_(0), exhausted_(true), error_(false)
+        {
+            swap(other);
+        }
+
+        ~prefetch_source() noexcept
+        {
+            close();
+        }
+
+        prefetch_source& operator=(prefetch_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(prefetch_source& other) noexcept
+        {
+            state_.swap(other.state_);
+            thread_.swap(other.thread_);
+            current_.swap(other.current_);
+            std::swap(offset_,other.offset_);
+            std::swap(position_,other.position_);
+            std::swap(exhausted_,other.exhausted_);
+            std::swap(error_,other.error_);
+            view_buffer_.swap(other.view_buffer_);
+        }
+
+        // Stops the helper thread and waits for it to finish
+        void close() noexcept
+        {
+            if (thread_.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state_->mutex);
+                    state_->stop = true;
+                }
+                state_->cv.notify_all();
+                thread_.join();
+            }
+            exhausted_ = true;
+        }
+
+        bool eof() const
+        {
+            return offset_ == current_.size() && exhausted_;
+        }
+
+        bool is_error() const
+        {
+            return error_;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (offset_ == current_.size() && !fetch())
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(current_[offset_++]);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0 && (offset_ < current_.size() || fetch()))
+            {
+                std::size_t len = (std::min)(count, current_.size() - offset_);
+                offset_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (offset_ == current_.size() && !fetch())
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(current_[offset_]);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && (offset_ < current_.size() || fetch()))
+            {
+                std::size_t len = (std::min)(length - count, current_.size() - offset_);
+                std::memcpy(p + count, current_.data() + offset_, len*sizeof(value_type));
+                offset_ += len;
+                count += len;
+            }
+            position_ += count;
+            return count;
+        }
+
+        // Returns the rest of the current block in place, waiting for the next block
+        // if the current one is used up. Empty at the end of the input.
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            if (offset_ == current_.size() && !fetch())
+            {
+                return jsoncons::detail::span<const value_type>();
+            }
+            jsoncons::detail::span<const value_type> s(current_.data() + offset_, current_.size() - offset_);
+            offset_ = current_.size();
+            position_ += s.size();
+            return s;
+        }
+
+        // Returns the next length values, in place if they lie in the current block,
+        // or fewer if the input ends first. The values remain valid until the next call
+        // on the source.
+        jsoncons::detail::span<const value_type> read_view(std::size_t length)
+        {
+            if (current_.size() - offset_ >= length)
+            {
+                jsoncons::detail::span<const value_type> s(current_.data() + offset_, length);
+                offset_ += length;
+                position_ += length;
+                return s;
+            }
+            view_buffer_.resize(length);
+            std::size_t count = read(view_buffer_.data(), length);
+            return jsoncons::detail::span<const value_type>(view_buffer_.data(), count);
+        }
+
+    private:
+        // Takes the next block from the helper thread, waiting for it if necessary.
+        // Returns false at the end of the input.
+        bool fetch()
+        {
+            if (exhausted_)
+            {
+                return false;
+            }
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            state_->cv.wait(lock, [this]() {return state_->next_ready || state_->done;});
+            if (!state_->next_ready)
+            {
+                exhausted_ = true;
+                error_ = state_->error;
+                return false;
+            }
+            current_.swap(state_->next);
+            state_->next_ready = false;
+            lock.unlock();
+            state_->cv.notify_all();
+
+            offset_ = 0;
+            return !current_.empty();
+        }
+
+        // Runs on the helper thread. Reads the next block while the previous one
+        // waits to be taken, until the source ends, fails, or the reader stops.
+        static void read_ahead(shared_state& state)
+        {
+            std::vector<value_type> block;
+            bool done = false;
+            while (!done)
+            {
+                block.resize(state.block_size);
+                std::size_t count = 0;
+                bool error = false;
+                JSONCONS_TRY
+                {
+                    count = state.source.read(block.data(), block.size());
+                    error = state.source.is_error();
+                }
+                JSONCONS_CATCH(...)
+                {
+                    error = true;
+                }
+                block.resize(count);
+                done = count == 0 || error || state.source.eof();
+
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.cv.wait(lock, [&state]() {return !state.next_ready || state.stop;});
+                if (state.stop)
+                {
+                    break;
+                }
+                if (count > 0)
+                {
+                    state.next.swap(block);
+                    state.next_ready = true;
+                }
+                state.error = error;
+                state.done = done;
+                lock.unlock();
+                state.cv.notify_all();
+            }
+        }
+    };
+
+    template <class Source>
+    constexpr std::size_t prefetch_source<Source>::default_block_size;
+
+} // namespace jsoncons
+
+#endif
@@ -13,11 +13,13 @@
 #include <istream>
 #include <memory> // std::addressof
 #include <cstring> // std::memcpy
+#include <algorithm> // std::min
 #include <exception>
 #include <type_traits> // std::enable_if
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/byte_string.hpp> // jsoncons::byte_traits
 #include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/span.hpp>
 
 namespace jsoncons { 
 
@@ -345,6 +347,169 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        // Returns the remaining characters in place, without copying them
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            jsoncons::detail::span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
+    };
+
+    // has_read_buffer
+
+    template <class Source>
+    using source_read_buffer_t = decltype(std::declval<Source>().read_buffer());
+
+    template <class Source>
+    using has_read_buffer = jsoncons::detail::is_detected<source_read_buffer_t, Source>;
+
+    // scatter_source
+
+    // Reads a text that arrives in fragments, for example the frames of a network
+    // message, without joining them. Fragments are added as (pointer,length) pairs
+    // and must outlive the source. Each call to read_buffer() hands the parser the
+    // rest of the current fragment in place, the parser carries strings, numbers and
+    // literals that span fragments over to the next one.
+    template <class CharT>
+    class scatter_source 
+    {
+    public:
+        using value_type = CharT;
+    private:
+        std::vector<jsoncons::detail::span<const value_type>> fragments_;
+        std::size_t index_;    // current fragment, fragments_.size() at the end
+        std::size_t offset_;   // next unread character in the current fragment
+        std::size_t position_;
+
+        // Noncopyable 
+        scatter_source(const scatter_source&) = delete;
+        scatter_source& operator=(const scatter_source&) = delete;
+    public:
+        scatter_source()
+            : index_(0), offset_(0), position_(0)
+        {
+        }
+
+        template <class Fragments>
+        scatter_source(const Fragments& fragments,
+                       typename std::enable_if<is_string_sourceable<value_type,typename Fragments::value_type>::value>::type* = 0)
+            : index_(0), offset_(0), position_(0)
+        {
+            for (const auto& fragment : fragments)
+            {
+                add(fragment.data(), fragment.size());
+            }
+        }
+
+        scatter_source(scatter_source&& other) 
+            : index_(0), offset_(0), position_(0)
+        {
+            swap(other);
+        }
+
+        scatter_source& operator=(scatter_source&& other)
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(scatter_source& other)
+        {
+            fragments_.swap(other.fragments_);
+            std::swap(index_,other.index_);
+            std::swap(offset_,other.offset_);
+            std::swap(position_,other.position_);
+        }
+
+        // Appends a fragment, empty fragments are skipped
+        void add(const value_type* data, std::size_t length)
+        {
+            if (length > 0)
+            {
+                fragments_.emplace_back(data, length);
+            }
+        }
+
+        bool eof() const
+        {
+            return index_ == fragments_.size();  
+        }
+
+        bool is_error() const
+        {
+            return false;  
+        }
+
+        std::size_t position() const
+        {
+            return position_ + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (index_ == fragments_.size())
+            {
+                return character_result<value_type>();
+            }
+            value_type c = fragments_[index_][offset_];
+            advance(1);
+            return character_result<value_type>(c);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0 && index_ < fragments_.size())
+            {
+                std::size_t len = (std::min)(count, fragments_[index_].size() - offset_);
+                advance(len);
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character() 
+        {
+            return index_ < fragments_.size() ? character_result<value_type>(fragments_[index_][offset_]) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && index_ < fragments_.size())
+            {
+                std::size_t len = (std::min)(length - count, fragments_[index_].size() - offset_);
+                std::memcpy(p + count, fragments_[index_].data() + offset_, len*sizeof(value_type));
+                advance(len);
+                count += len;
+            }
+            return count;
+        }
+
+        // Returns the rest of the current fragment in place, without copying it
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            if (index_ == fragments_.size())
+            {
+                return jsoncons::detail::span<const value_type>();
+            }
+            jsoncons::detail::span<const value_type> s(fragments_[index_].data() + offset_, fragments_[index_].size() - offset_);
+            advance(s.size());
+            return s;
+        }
+
+    private:
+        // Moves past count characters of the current fragment, at most to its end
+        void advance(std::size_t count)
+        {
+            offset_ += count;
+            position_ += count;
+            if (offset_ == fragments_[index_].size())
+            {
+                ++index_;
+                offset_ = 0;
+            }
+        }
     };
 
     // iterator source
@@ -425,58 +590,64 @@ namespace jsoncons {
 
     // binary sources
 
-    class binary_stream_source 
+    // Reads the stream in blocks, so that peeking at, getting and reading bytes are
+    // inline operations on the block most of the time. Bytes read ahead are put back
+    // into the stream, if it supports seeking, when the source is destroyed.
+    class binary_stream_source
     {
     public:
         typedef uint8_t value_type;
+        static constexpr std::size_t default_max_buffer_size = 16384;
     private:
         using traits_type = byte_traits;
         basic_null_istream<char> null_is_;
         std::istream* stream_ptr_;
         std::streambuf* sbuf_;
         std::size_t position_;
+        std::vector<value_type> buffer_;
+        std::size_t begin_; // next unread byte in buffer_
+        std::size_t end_;   // end of the bytes read into buffer_
 
-        // Noncopyable 
+        // Noncopyable
         binary_stream_source(const binary_stream_source&) = delete;
         binary_stream_source& operator=(const binary_stream_source&) = delete;
     public:
         binary_stream_source()
-            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()), position_(0)
+            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()), position_(0), begin_(0), end_(0)
         {
         }
 
-        binary_stream_source(std::istream& is)
-            : stream_ptr_(std::addressof(is)), sbuf_(is.rdbuf()), position_(0)
+        binary_stream_source(std::istream& is, std::size_t buffer_size = default_max_buffer_size)
+            : stream_ptr_(std::addressof(is)), sbuf_(is.rdbuf()), position_(0),
+              buffer_(buffer_size > 0 ? buffer_size : 1), begin_(0), end_(0)
         {
         }
 
         binary_stream_source(binary_stream_source&& other) noexcept
+            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()), position_(0), begin_(0), end_(0)
         {
-            std::swap(stream_ptr_,other.stream_ptr_);
-            std::swap(sbuf_,other.sbuf_);
-            std::swap(position_,other.position_);
+            swap(other);
         }
 
-        ~binary_stream_source()
+        ~binary_stream_source() noexcept
         {
+            put_back();
         }
 
         binary_stream_source& operator=(binary_stream_source&& other) noexcept
         {
-            std::swap(stream_ptr_,other.stream_ptr_);
-            std::swap(sbuf_,other.sbuf_);
-            std::swap(position_,other.position_);
+            swap(other);
             return *this;
         }
 
         bool eof() const
         {
-            return stream_ptr_->eof();  
+            return stream_ptr_->eof();
         }
 
         bool is_error() const
         {
-            return stream_ptr_->bad();  
+            return stream_ptr_->bad();
         }
 
         std::size_t position() const
@@ -486,85 +657,198 @@ namespace jsoncons {
 
         character_result<value_type> get_character()
         {
-            JSONCONS_TRY
+            if (begin_ < end_ || fill() > 0)
             {
-                int c = sbuf_->sbumpc();
-                if (c == traits_type::eof())
+                ++position_;
+                return character_result<value_type>(buffer_[begin_++]);
+            }
+            stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+            return character_result<value_type>();
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (begin_ == end_ && fill() == 0)
                 {
                     stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
-                    return character_result<value_type>();
+                    return;
                 }
-                ++position_;
-                return character_result<value_type>(static_cast<value_type>(c));
+                std::size_t len = (std::min)(count, end_ - begin_);
+                begin_ += len;
+                position_ += len;
+                count -= len;
             }
-            JSONCONS_CATCH(const std::exception&)     
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (begin_ < end_ || fill() > 0)
             {
-                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
-                return character_result<value_type>();
+                return character_result<value_type>(buffer_[begin_]);
             }
+            stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+            return character_result<value_type>();
         }
 
-        void ignore(std::size_t count)
+        std::size_t read(value_type* p, std::size_t length)
         {
-            JSONCONS_TRY
+            std::size_t count = (std::min)(length, end_ - begin_);
+            std::memcpy(p, buffer_.data() + begin_, count);
+            begin_ += count;
+
+            if (count < length)
             {
-                for (std::size_t i = 0; i < count; ++i)
+                if (length - count >= buffer_.size())
                 {
-                    int c = sbuf_->sbumpc();
-                    if (c == traits_type::eof())
-                    {
-                        stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
-                        return;
-                    }
-                    else
+                    // Large reads go straight to the stream
+                    count += read_stream(p + count, length - count);
+                }
+                else
+                {
+                    while (count < length && fill() > 0)
                     {
-                        ++position_;
+                        std::size_t len = (std::min)(length - count, end_ - begin_);
+                        std::memcpy(p + count, buffer_.data() + begin_, len);
+                        begin_ += len;
+                        count += len;
                     }
                 }
+                if (count < length)
+                {
+                    stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+                }
             }
-            JSONCONS_CATCH(const std::exception&)     
+            position_ += count;
+            return count;
+        }
+
+        // Returns the next length bytes in place, or fewer if the stream ends first.
+        // The bytes remain valid until the next call on the source.
+        jsoncons::detail::span<const value_type> read_view(std::size_t length)
+        {
+            if (end_ - begin_ < length)
             {
-                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
+                if (length > buffer_.size())
+                {
+                    buffer_.resize(length);
+                }
+                while (end_ - begin_ < length && fill() > 0)
+                {
+                }
+            }
+            std::size_t count = (std::min)(length, end_ - begin_);
+            if (count < length)
+            {
+                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
             }
+            jsoncons::detail::span<const value_type> s(buffer_.data() + begin_, count);
+            begin_ += count;
+            position_ += count;
+            return s;
         }
 
-        character_result<value_type> peek_character() 
+    private:
+        void swap(binary_stream_source& other) noexcept
         {
+            // A source that reads from its own null stream must keep reading from it
+            bool this_null = stream_ptr_ == &null_is_;
+            bool other_null = other.stream_ptr_ == &other.null_is_;
+            std::swap(stream_ptr_,other.stream_ptr_);
+            std::swap(sbuf_,other.sbuf_);
+            if (other_null)
+            {
+                stream_ptr_ = &null_is_;
+                sbuf_ = null_is_.rdbuf();
+            }
+            if (this_null)
+            {
+                other.stream_ptr_ = &other.null_is_;
+                other.sbuf_ = other.null_is_.rdbuf();
+            }
+            std::swap(position_,other.position_);
+            buffer_.swap(other.buffer_);
+            std::swap(begin_,other.begin_);
+            std::swap(end_,other.end_);
+        }
+
+        // Moves the unread bytes to the front of the buffer and reads after them the bytes
+        // that the stream buffer already holds, waiting only when it holds none, so that
+        // a pipe or socket is never asked for more than is needed. Returns the number
+        // of bytes read.
+        std::size_t fill()
+        {
+            if (begin_ > 0)
+            {
+                std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+                end_ -= begin_;
+                begin_ = 0;
+            }
+            if (end_ == buffer_.size() || stream_ptr_->bad())
+            {
+                return 0;
+            }
             JSONCONS_TRY
             {
-                int c = sbuf_->sgetc();
-                if (c == traits_type::eof())
+                if (sbuf_->sgetc() == traits_type::eof())
                 {
-                    stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
-                    return character_result<value_type>();
+                    return 0;
                 }
-                return character_result<value_type>(static_cast<value_type>(c));
+                std::streamsize avail = sbuf_->in_avail();
+                std::size_t length = avail > 0 ? (std::min)(static_cast<std::size_t>(avail), buffer_.size() - end_) : 1;
+                std::streamsize count = sbuf_->sgetn(reinterpret_cast<char*>(buffer_.data() + end_), length); // never negative
+                end_ += static_cast<std::size_t>(count);
+                return static_cast<std::size_t>(count);
             }
-            JSONCONS_CATCH(const std::exception&)     
+            JSONCONS_CATCH(const std::exception&)
             {
-                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit);
-                return character_result<value_type>();
+                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
+                return 0;
             }
         }
 
-        std::size_t read(value_type* p, std::size_t length)
+        std::size_t read_stream(value_type* p, std::size_t length)
         {
+            if (length == 0 || stream_ptr_->bad())
+            {
+                return 0;
+            }
             JSONCONS_TRY
             {
                 std::streamsize count = sbuf_->sgetn(reinterpret_cast<char*>(p), length); // never negative
-                if (static_cast<std::size_t>(count) < length)
-                {
-                    stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
-                }
-                position_ += length;
                 return static_cast<std::size_t>(count);
             }
-            JSONCONS_CATCH(const std::exception&)     
+            JSONCONS_CATCH(const std::exception&)
             {
                 stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
                 return 0;
             }
         }
+
+        // Returns the unread bytes to the stream buffer's putback area, which does not
+        // need a seekable stream, and seeks back over any that do not fit
+        void put_back() noexcept
+        {
+            if (begin_ < end_ && stream_ptr_ != &null_is_)
+            {
+                JSONCONS_TRY
+                {
+                    while (end_ > begin_ && sbuf_->sputbackc(static_cast<char>(buffer_[end_ - 1])) != std::char_traits<char>::eof())
+                    {
+                        --end_;
+                    }
+                    if (end_ > begin_)
+                    {
+                        sbuf_->pubseekoff(-static_cast<std::streamoff>(end_ - begin_), std::ios::cur, std::ios::in);
+                    }
+                }
+                JSONCONS_CATCH(...)
+                {
+                }
+            }
+            begin_ = end_ = 0;
+        }
     };
 
     class bytes_source 
@@ -659,6 +943,166 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        // Returns the next length bytes in place, or fewer if the input ends first
+        jsoncons::detail::span<const value_type> read_view(std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(end_ - current_));
+            jsoncons::detail::span<const value_type> s(current_, len);
+            current_ += len;
+            return s;
+        }
+    };
+
+    // binary_scatter_source
+
+    // Reads binary data that arrives in fragments without joining them. Fragments are
+    // added as (pointer,length) pairs and must outlive the source. Strings and byte
+    // strings that span fragments are copied piecewise into the parser's buffer, only a
+    // fixed width value that spans fragments is assembled in a small buffer.
+    class binary_scatter_source 
+    {
+    public:
+        typedef uint8_t value_type;
+    private:
+        std::vector<jsoncons::detail::span<const value_type>> fragments_;
+        std::size_t index_;    // current fragment, fragments_.size() at the end
+        std::size_t offset_;   // next unread character in the current fragment
+        std::size_t position_;
+        std::vector<value_type> view_buffer_; // a fixed width value that spans fragments
+
+        // Noncopyable 
+        binary_scatter_source(const binary_scatter_source&) = delete;
+        binary_scatter_source& operator=(const binary_scatter_source&) = delete;
+    public:
+        binary_scatter_source()
+            : index_(0), offset_(0), position_(0)
+        {
+        }
+
+        template <class Fragments>
+        binary_scatter_source(const Fragments& fragments,
+                       typename std::enable_if<jsoncons::detail::is_byte_sequence<typename Fragments::value_type>::value>::type* = 0)
+            : index_(0), offset_(0), position_(0)
+        {
+            for (const auto& fragment : fragments)
+            {
+                add(reinterpret_cast<const value_type*>(fragment.data()), fragment.size());
+            }
+        }
+
+        binary_scatter_source(binary_scatter_source&& other) 
+            : index_(0), offset_(0), position_(0)
+        {
+            swap(other);
+        }
+
+        binary_scatter_source& operator=(binary_scatter_source&& other)
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(binary_scatter_source& other)
+        {
+            fragments_.swap(other.fragments_);
+            std::swap(index_,other.index_);
+            std::swap(offset_,other.offset_);
+            std::swap(position_,other.position_);
+            view_buffer_.swap(other.view_buffer_);
+        }
+
+        // Appends a fragment, empty fragments are skipped
+        void add(const value_type* data, std::size_t length)
+        {
+            if (length > 0)
+            {
+                fragments_.emplace_back(data, length);
+            }
+        }
+
+        bool eof() const
+        {
+            return index_ == fragments_.size();  
+        }
+
+        bool is_error() const
+        {
+            return false;  
+        }
+
+        std::size_t position() const
+        {
+            return position_ + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (index_ == fragments_.size())
+            {
+                return character_result<value_type>();
+            }
+            value_type c = fragments_[index_][offset_];
+            advance(1);
+            return character_result<value_type>(c);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0 && index_ < fragments_.size())
+            {
+                std::size_t len = (std::min)(count, fragments_[index_].size() - offset_);
+                advance(len);
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character() 
+        {
+            return index_ < fragments_.size() ? character_result<value_type>(fragments_[index_][offset_]) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && index_ < fragments_.size())
+            {
+                std::size_t len = (std::min)(length - count, fragments_[index_].size() - offset_);
+                std::memcpy(p + count, fragments_[index_].data() + offset_, len);
+                advance(len);
+                count += len;
+            }
+            return count;
+        }
+
+        // Returns the next length bytes, in place if they lie in the current fragment,
+        // or fewer if the input ends first. The bytes remain valid until the next call
+        // on the source.
+        jsoncons::detail::span<const value_type> read_view(std::size_t length)
+        {
+            if (index_ < fragments_.size() && fragments_[index_].size() - offset_ >= length)
+            {
+                jsoncons::detail::span<const value_type> s(fragments_[index_].data() + offset_, length);
+                advance(length);
+                return s;
+            }
+            view_buffer_.resize(length);
+            std::size_t count = read(view_buffer_.data(), length);
+            return jsoncons::detail::span<const value_type>(view_buffer_.data(), count);
+        }
+
+    private:
+        // Moves past count bytes of the current fragment, at most to its end
+        void advance(std::size_t count)
+        {
+            offset_ += count;
+            position_ += count;
+            if (offset_ == fragments_[index_].size())
+            {
+                ++index_;
+                offset_ = 0;
+            }
+        }
     };
 
     // binary_iterator source
@@ -737,12 +1181,40 @@ namespace jsoncons {
         }
     };
 
+    // has_read_view
+
+    template <class Source>
+    using source_read_view_t = decltype(std::declval<Source>().read_view(std::size_t()));
+
+    template <class Source>
+    using has_read_view = jsoncons::detail::is_detected<source_read_view_t, Source>;
+
     template <class Source>
     struct source_reader
     {
         using value_type = typename Source::value_type;
         static constexpr std::size_t max_buffer_length = 16384;
 
+        // Reads length bytes for decoding a fixed width value. Returns a pointer to them,
+        // in place for sources with read_view, otherwise copied into buf, or nullptr if
+        // the source ends first.
+        template <class S = Source>
+        static 
+        typename std::enable_if<has_read_view<S>::value,const value_type*>::type
+        read_fixed(Source& source, value_type*, std::size_t length)
+        {
+            auto s = source.read_view(length);
+            return s.size() == length ? s.data() : nullptr;
+        }
+
+        template <class S = Source>
+        static 
+        typename std::enable_if<!has_read_view<S>::value,const value_type*>::type
+        read_fixed(Source& source, value_type* buf, std::size_t length)
+        {
+            return source.read(buf, length) == length ? buf : nullptr;
+        }
+
         template <class Container>
         static
         typename std::enable_if<std::is_convertible<value_type,typename Container::value_type>::value &&
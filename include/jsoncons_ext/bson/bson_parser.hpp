@@ -192,13 +192,14 @@ private:
             return;
         } 
         uint8_t buf[sizeof(int32_t)]; 
-        if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+        const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+        if (p == nullptr)
         {
             ec = bson_errc::unexpected_eof;
             more_ = false;
             return;
         }
-        auto length = jsoncons::detail::little_to_native<int32_t>(buf, sizeof(buf));
+        auto length = jsoncons::detail::little_to_native<int32_t>(p, sizeof(buf));
 
         more_ = visitor.begin_object(semantic_tag::none, *this, ec);
         state_stack_.emplace_back(parse_mode::document,length);
@@ -220,13 +221,14 @@ private:
             return;
         } 
         uint8_t buf[sizeof(int32_t)]; 
-        if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+        const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+        if (p == nullptr)
         {
             ec = bson_errc::unexpected_eof;
             more_ = false;
             return;
         }
-        /* auto len = */ jsoncons::detail::little_to_native<int32_t>(buf, sizeof(buf));
+        /* auto len = */ jsoncons::detail::little_to_native<int32_t>(p, sizeof(buf));
 
         more_ = visitor.begin_array(semantic_tag::none, *this, ec);
         state_stack_.emplace_back(parse_mode::array,0);
@@ -268,26 +270,28 @@ private:
             case jsoncons::bson::detail::bson_format::double_cd:
             {
                 uint8_t buf[sizeof(double)]; 
-                if (source_.read(buf, sizeof(double)) != sizeof(double))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(double));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                double res = jsoncons::detail::little_to_native<double>(buf, sizeof(buf));
+                double res = jsoncons::detail::little_to_native<double>(p, sizeof(buf));
                 more_ = visitor.double_value(res, semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::bson::detail::bson_format::string_cd:
             {
                 uint8_t buf[sizeof(int32_t)]; 
-                if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                auto len = jsoncons::detail::little_to_native<int32_t>(buf, sizeof(buf));
+                auto len = jsoncons::detail::little_to_native<int32_t>(p, sizeof(buf));
                 if (len < 1)
                 {
                     ec = bson_errc::string_length_is_non_positive;
@@ -351,13 +355,14 @@ private:
             case jsoncons::bson::detail::bson_format::int32_cd: 
             {
                 uint8_t buf[sizeof(int32_t)]; 
-                if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                auto val = jsoncons::detail::little_to_native<int32_t>(buf, sizeof(buf));
+                auto val = jsoncons::detail::little_to_native<int32_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                 break;
             }
@@ -365,13 +370,14 @@ private:
             case jsoncons::bson::detail::bson_format::timestamp_cd: 
             {
                 uint8_t buf[sizeof(uint64_t)]; 
-                if (source_.read(buf, sizeof(uint64_t)) != sizeof(uint64_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint64_t));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                auto val = jsoncons::detail::little_to_native<uint64_t>(buf, sizeof(buf));
+                auto val = jsoncons::detail::little_to_native<uint64_t>(p, sizeof(buf));
                 more_ = visitor.uint64_value(val, semantic_tag::timestamp, *this, ec);
                 break;
             }
@@ -379,13 +385,14 @@ private:
             case jsoncons::bson::detail::bson_format::int64_cd: 
             {
                 uint8_t buf[sizeof(int64_t)]; 
-                if (source_.read(buf, sizeof(int64_t)) != sizeof(int64_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int64_t));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                auto val = jsoncons::detail::little_to_native<int64_t>(buf, sizeof(buf));
+                auto val = jsoncons::detail::little_to_native<int64_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                 break;
             }
@@ -393,26 +400,28 @@ private:
             case jsoncons::bson::detail::bson_format::datetime_cd: 
             {
                 uint8_t buf[sizeof(int64_t)]; 
-                if (source_.read(buf, sizeof(int64_t)) != sizeof(int64_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int64_t));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                auto val = jsoncons::detail::little_to_native<int64_t>(buf, sizeof(buf));
+                auto val = jsoncons::detail::little_to_native<int64_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::timestamp, *this, ec);
                 break;
             }
             case jsoncons::bson::detail::bson_format::binary_cd: 
             {
                 uint8_t buf[sizeof(int32_t)]; 
-                if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                if (p == nullptr)
                 {
                     ec = bson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                const auto len = jsoncons::detail::little_to_native<int32_t>(buf, sizeof(buf));
+                const auto len = jsoncons::detail::little_to_native<int32_t>(p, sizeof(buf));
                 if (len < 0)
                 {
                     ec = bson_errc::length_is_negative;
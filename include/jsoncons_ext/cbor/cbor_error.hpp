@@ -27,7 +27,10 @@ enum class cbor_errc
     stringref_too_large,
     max_nesting_depth_exceeded,
     unknown_type,
-    illegal_chunked_string
+    illegal_chunked_string,
+    max_input_length_exceeded,
+    max_string_length_exceeded,
+    max_container_length_exceeded
 };
 
 class cbor_error_category_impl
@@ -66,6 +69,12 @@ public:
                 return "An unknown type was found in the stream";
             case cbor_errc::illegal_chunked_string:
                 return "An illegal type was found while parsing an indefinite length string";
+            case cbor_errc::max_input_length_exceeded:
+                return "Input length exceeds limit in options";
+            case cbor_errc::max_string_length_exceeded:
+                return "String length exceeds limit in options";
+            case cbor_errc::max_container_length_exceeded:
+                return "Array or map length exceeds limit in options";
             default:
                 return "Unknown CBOR parser error";
         }
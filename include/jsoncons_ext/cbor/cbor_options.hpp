@@ -44,9 +44,34 @@ public:
 class cbor_decode_options : public virtual cbor_options_common
 {
     friend class cbor_options;
+
+    std::size_t max_input_length_;
+    std::size_t max_string_length_;
+    std::size_t max_container_length_;
 public:
     cbor_decode_options()
+        : max_input_length_((std::numeric_limits<std::size_t>::max)()),
+          max_string_length_((std::numeric_limits<std::size_t>::max)()),
+          max_container_length_((std::numeric_limits<std::size_t>::max)())
+    {
+    }
+
+    // The maximum number of bytes read from the input
+    std::size_t max_input_length() const 
     {
+        return max_input_length_;
+    }
+
+    // The maximum length in bytes of a text string or byte string
+    std::size_t max_string_length() const 
+    {
+        return max_string_length_;
+    }
+
+    // The maximum number of items in an array or pairs in a map, as given by its header
+    std::size_t max_container_length() const 
+    {
+        return max_container_length_;
     }
 };
 
@@ -78,6 +103,9 @@ class cbor_options final : public cbor_decode_options, public cbor_encode_option
 {
 public:
     using cbor_options_common::max_nesting_depth;
+    using cbor_decode_options::max_input_length;
+    using cbor_decode_options::max_string_length;
+    using cbor_decode_options::max_container_length;
     using cbor_encode_options::pack_strings;
     using cbor_encode_options::use_typed_arrays;
 
@@ -87,6 +115,24 @@ public:
         return *this;
     }
 
+    cbor_options& max_input_length(std::size_t value)
+    {
+        this->max_input_length_ = value;
+        return *this;
+    }
+
+    cbor_options& max_string_length(std::size_t value)
+    {
+        this->max_string_length_ = value;
+        return *this;
+    }
+
+    cbor_options& max_container_length(std::size_t value)
+    {
+        this->max_container_length_ = value;
+        return *this;
+    }
+
     cbor_options& pack_strings(bool value)
     {
         this->use_stringref_ = value;
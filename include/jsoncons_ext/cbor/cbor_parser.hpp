@@ -113,6 +113,7 @@ class basic_cbor_parser : public ser_context
     std::size_t index_;
     std::vector<stringref_map,stringref_map_allocator_type> stringref_map_stack_;
     int nesting_depth_;
+    std::size_t input_begin_;
 
     struct read_byte_string_from_buffer
     {
@@ -168,6 +169,7 @@ public:
          stringref_map_stack_(alloc),
          nesting_depth_(0)
     {
+        input_begin_ = source_.position();
         state_stack_.emplace_back(parse_mode::root,0);
     }
 
@@ -182,6 +184,7 @@ public:
         state_stack_.emplace_back(parse_mode::root,0);
         more_ = true;
         done_ = false;
+        input_begin_ = source_.position();
     }
 
     bool done() const
@@ -208,122 +211,147 @@ public:
     {
         while (!done_ && more_)
         {
-            switch (state_stack_.back().mode)
+            parse_item(visitor, ec);
+        }
+    }
+
+    // Parses at most max_items data items, or the ends of arrays and maps, and
+    // returns the number parsed. If the parser is neither done nor stopped
+    // afterwards, a later call resumes where this one stopped.
+    std::size_t parse(json_visitor2& visitor, std::size_t max_items, std::error_code& ec)
+    {
+        std::size_t count = 0;
+        while (!done_ && more_ && count < max_items)
+        {
+            parse_item(visitor, ec);
+            ++count;
+        }
+        return count;
+    }
+private:
+    void parse_item(json_visitor2& visitor, std::error_code& ec)
+    {
+        switch (state_stack_.back().mode)
+        {
+            case parse_mode::multi_dim:
             {
-                case parse_mode::multi_dim:
+                if (state_stack_.back().index == 0)
                 {
-                    if (state_stack_.back().index == 0)
-                    {
-                        ++state_stack_.back().index;
-                        read_item(visitor, ec);
-                    }
-                    else
-                    {
-                        produce_end_multi_dim(visitor, ec);
-                    }
-                    break;
+                    ++state_stack_.back().index;
+                    read_item(visitor, ec);
                 }
-                case parse_mode::array:
+                else
                 {
-                    if (state_stack_.back().index < state_stack_.back().length)
-                    {
-                        ++state_stack_.back().index;
-                        read_item(visitor, ec);
-                    }
-                    else
-                    {
-                        end_array(visitor, ec);
-                    }
-                    break;
+                    produce_end_multi_dim(visitor, ec);
                 }
-                case parse_mode::indefinite_array:
+                break;
+            }
+            case parse_mode::array:
+            {
+                if (state_stack_.back().index < state_stack_.back().length)
                 {
-                    auto c = source_.peek_character();
-                    if (!c)
-                    {
-                        ec = cbor_errc::unexpected_eof;
-                        more_ = false;
-                        return;
-                    }
-                    if (c.value() == 0xff)
-                    {
-                        source_.ignore(1);
-                        end_array(visitor, ec);
-                    }
-                    else
-                    {
-                        read_item(visitor, ec);
-                    }
-                    break;
+                    ++state_stack_.back().index;
+                    read_item(visitor, ec);
                 }
-                case parse_mode::map_key:
+                else
                 {
-                    if (state_stack_.back().index < state_stack_.back().length)
-                    {
-                        ++state_stack_.back().index;
-                        state_stack_.back().mode = parse_mode::map_value;
-                        read_item(visitor, ec);
-                    }
-                    else
-                    {
-                        end_object(visitor, ec);
-                    }
-                    break;
+                    end_array(visitor, ec);
                 }
-                case parse_mode::map_value:
+                break;
+            }
+            case parse_mode::indefinite_array:
+            {
+                auto c = source_.peek_character();
+                if (!c)
                 {
-                    state_stack_.back().mode = parse_mode::map_key;
-                    read_item(visitor, ec);
-                    break;
+                    ec = cbor_errc::unexpected_eof;
+                    more_ = false;
+                    return;
                 }
-                case parse_mode::indefinite_map_key:
+                if (c.value() == 0xff)
                 {
-                    auto c = source_.peek_character();
-                    if (!c)
-                    {
-                        ec = cbor_errc::unexpected_eof;
-                        more_ = false;
-                        return;
-                    }
-                    if (c.value() == 0xff)
-                    {
-                        source_.ignore(1);
-                        end_object(visitor, ec);
-                    }
-                    else
-                    {
-                        state_stack_.back().mode = parse_mode::indefinite_map_value;
-                        read_item(visitor, ec);
-                    }
-                    break;
+                    source_.ignore(1);
+                    end_array(visitor, ec);
                 }
-                case parse_mode::indefinite_map_value:
+                else
                 {
-                    state_stack_.back().mode = parse_mode::indefinite_map_key;
                     read_item(visitor, ec);
-                    break;
                 }
-                case parse_mode::root:
+                break;
+            }
+            case parse_mode::map_key:
+            {
+                if (state_stack_.back().index < state_stack_.back().length)
                 {
-                    state_stack_.back().mode = parse_mode::before_done;
+                    ++state_stack_.back().index;
+                    state_stack_.back().mode = parse_mode::map_value;
                     read_item(visitor, ec);
-                    break;
                 }
-                case parse_mode::before_done:
+                else
                 {
-                    JSONCONS_ASSERT(state_stack_.size() == 1);
-                    state_stack_.clear();
+                    end_object(visitor, ec);
+                }
+                break;
+            }
+            case parse_mode::map_value:
+            {
+                state_stack_.back().mode = parse_mode::map_key;
+                read_item(visitor, ec);
+                break;
+            }
+            case parse_mode::indefinite_map_key:
+            {
+                auto c = source_.peek_character();
+                if (!c)
+                {
+                    ec = cbor_errc::unexpected_eof;
                     more_ = false;
-                    done_ = true;
-                    visitor.flush();
-                    break;
+                    return;
+                }
+                if (c.value() == 0xff)
+                {
+                    source_.ignore(1);
+                    end_object(visitor, ec);
                 }
+                else
+                {
+                    state_stack_.back().mode = parse_mode::indefinite_map_value;
+                    read_item(visitor, ec);
+                }
+                break;
+            }
+            case parse_mode::indefinite_map_value:
+            {
+                state_stack_.back().mode = parse_mode::indefinite_map_key;
+                read_item(visitor, ec);
+                break;
+            }
+            case parse_mode::root:
+            {
+                state_stack_.back().mode = parse_mode::before_done;
+                read_item(visitor, ec);
+                break;
+            }
+            case parse_mode::before_done:
+            {
+                JSONCONS_ASSERT(state_stack_.size() == 1);
+                state_stack_.clear();
+                more_ = false;
+                done_ = true;
+                visitor.flush();
+                break;
             }
         }
     }
-private:
+
     void read_item(json_visitor2& visitor, std::error_code& ec)
     {
+        if (JSONCONS_UNLIKELY(input_read() > options_.max_input_length()))
+        {
+            ec = cbor_errc::max_input_length_exceeded;
+            more_ = false;
+            return;
+        }
         read_tags(ec);
         if (!more_)
         {
@@ -602,7 +630,7 @@ private:
             default: // definite length
             {
                 std::size_t len = get_size(ec);
-                if (!more_)
+                if (!more_ || !check_container_length(len, ec))
                 {
                     return;
                 }
@@ -652,7 +680,7 @@ private:
             default: // definite_length
             {
                 std::size_t len = get_size(ec);
-                if (!more_)
+                if (!more_ || !check_container_length(len, ec))
                 {
                     return;
                 }
@@ -705,6 +733,53 @@ private:
         }
     }
 
+    // Checks the length of an array or map, from its header, against the limits in
+    // the options. Each item takes at least one byte of input.
+    bool check_container_length(std::size_t length, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(length > options_.max_container_length()))
+        {
+            ec = cbor_errc::max_container_length_exceeded;
+            more_ = false;
+            return false;
+        }
+        return check_input_length(length, ec);
+    }
+
+    // Checks the length of a string, or of the next chunk of an indefinite length
+    // string following read bytes, against the limits in the options before it is read
+    bool check_string_length(std::size_t read, std::size_t length, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(read > options_.max_string_length() || 
+                              length > options_.max_string_length() - read))
+        {
+            ec = cbor_errc::max_string_length_exceeded;
+            more_ = false;
+            return false;
+        }
+        return check_input_length(length, ec);
+    }
+
+    // The number of bytes read since construction or the last reset, sources differ
+    // on whether position() starts at zero or one
+    std::size_t input_read() const
+    {
+        return source_.position() - input_begin_;
+    }
+
+    bool check_input_length(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = input_read();
+        if (JSONCONS_UNLIKELY(position > options_.max_input_length() || 
+                              length > options_.max_input_length() - position))
+        {
+            ec = cbor_errc::max_input_length_exceeded;
+            more_ = false;
+            return false;
+        }
+        return true;
+    }
+
     std::size_t get_size(std::error_code& ec)
     {
         uint64_t u = get_uint64_value(ec);
@@ -752,12 +827,16 @@ private:
                     return true;
                 };
                 iterate_string_chunks(func, major_type, ec);
+                if (ec)
+                {
+                    more = false;
+                }
                 break;
             }
             default:
             {
                 std::size_t length = get_size(ec);
-                if (ec)
+                if (ec || !check_string_length(0, length, ec))
                 {
                     more = false;
                     return more;
@@ -783,6 +862,7 @@ private:
     void iterate_string_chunks(Function& func, jsoncons::cbor::detail::cbor_major_type type, std::error_code& ec)
     {
         int nesting_level = 0;
+        std::size_t read = 0;
 
         bool done = false;
         while (!done)
@@ -825,10 +905,11 @@ private:
                 default: // definite length
                 {
                     std::size_t length = get_size(ec);
-                    if (!more_)
+                    if (!more_ || !check_string_length(read, length, ec))
                     {
                         return;
                     }
+                    read += length;
                     more_ = func(source_, length, ec);
                     if (!more_)
                     {
@@ -880,24 +961,42 @@ private:
             case 0x19: // Unsigned integer (two-byte uint16_t follows)
             {
                 uint8_t buf[sizeof(uint16_t)];
-                source_.read(buf, sizeof(uint16_t));
-                val = jsoncons::detail::big_to_native<uint16_t>(buf, sizeof(buf));
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint16_t));
+                if (p == nullptr)
+                {
+                    ec = cbor_errc::unexpected_eof;
+                    more_ = false;
+                    return val;
+                }
+                val = jsoncons::detail::big_to_native<uint16_t>(p, sizeof(buf));
                 break;
             }
 
             case 0x1a: // Unsigned integer (four-byte uint32_t follows)
             {
                 uint8_t buf[sizeof(uint32_t)];
-                source_.read(buf, sizeof(uint32_t));
-                val = jsoncons::detail::big_to_native<uint32_t>(buf, sizeof(buf));
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint32_t));
+                if (p == nullptr)
+                {
+                    ec = cbor_errc::unexpected_eof;
+                    more_ = false;
+                    return val;
+                }
+                val = jsoncons::detail::big_to_native<uint32_t>(p, sizeof(buf));
                 break;
             }
 
             case 0x1b: // Unsigned integer (eight-byte uint64_t follows)
             {
                 uint8_t buf[sizeof(uint64_t)];
-                source_.read(buf, sizeof(uint64_t));
-                val = jsoncons::detail::big_to_native<uint64_t>(buf, sizeof(buf));
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint64_t));
+                if (p == nullptr)
+                {
+                    ec = cbor_errc::unexpected_eof;
+                    more_ = false;
+                    return val;
+                }
+                val = jsoncons::detail::big_to_native<uint64_t>(p, sizeof(buf));
                 break;
             }
             default:
@@ -947,13 +1046,14 @@ private:
                     case 0x19: // Negative integer -1-n (two-byte uint16_t follows)
                         {
                             uint8_t buf[sizeof(uint16_t)];
-                            if (source_.read(buf, sizeof(uint16_t)) != sizeof(uint16_t))
+                            const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint16_t));
+                            if (p == nullptr)
                             {
                                 ec = cbor_errc::unexpected_eof;
                                 more_ = false;
                                 return val;
                             }
-                            auto x = jsoncons::detail::big_to_native<uint16_t>(buf, sizeof(buf));
+                            auto x = jsoncons::detail::big_to_native<uint16_t>(p, sizeof(buf));
                             val = static_cast<int64_t>(-1)- x;
                             break;
                         }
@@ -961,13 +1061,14 @@ private:
                     case 0x1a: // Negative integer -1-n (four-byte uint32_t follows)
                         {
                             uint8_t buf[sizeof(uint32_t)];
-                            if (source_.read(buf, sizeof(uint32_t)) != sizeof(uint32_t))
+                            const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint32_t));
+                            if (p == nullptr)
                             {
                                 ec = cbor_errc::unexpected_eof;
                                 more_ = false;
                                 return val;
                             }
-                            auto x = jsoncons::detail::big_to_native<uint32_t>(buf, sizeof(buf));
+                            auto x = jsoncons::detail::big_to_native<uint32_t>(p, sizeof(buf));
                             val = static_cast<int64_t>(-1)- x;
                             break;
                         }
@@ -975,13 +1076,14 @@ private:
                     case 0x1b: // Negative integer -1-n (eight-byte uint64_t follows)
                         {
                             uint8_t buf[sizeof(uint64_t)];
-                            if (source_.read(buf, sizeof(uint64_t)) != sizeof(uint64_t))
+                            const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint64_t));
+                            if (p == nullptr)
                             {
                                 ec = cbor_errc::unexpected_eof;
                                 more_ = false;
                                 return val;
                             }
-                            auto x = jsoncons::detail::big_to_native<uint64_t>(buf, sizeof(buf));
+                            auto x = jsoncons::detail::big_to_native<uint64_t>(p, sizeof(buf));
                             val = static_cast<int64_t>(-1)- static_cast<int64_t>(x);
                             break;
                         }
@@ -1031,26 +1133,28 @@ private:
         case 0x1a: // Single-Precision Float (four-byte IEEE 754)
             {
                 uint8_t buf[sizeof(float)];
-                if (source_.read(buf, sizeof(float)) !=sizeof(float)) 
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(float));
+                if (p == nullptr)
                 {
                     ec = cbor_errc::unexpected_eof;
                     more_ = false;
                     return 0;
                 }
-                val = jsoncons::detail::big_to_native<float>(buf, sizeof(buf));
+                val = jsoncons::detail::big_to_native<float>(p, sizeof(buf));
                 break;
             }
 
         case 0x1b: //  Double-Precision Float (eight-byte IEEE 754)
             {
                 uint8_t buf[sizeof(double)];
-                if (source_.read(buf, sizeof(double)) != sizeof(double))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(double));
+                if (p == nullptr)
                 {
                     ec = cbor_errc::unexpected_eof;
                     more_ = false;
                     return 0;
                 }
-                val = jsoncons::detail::big_to_native<double>(buf, sizeof(buf));
+                val = jsoncons::detail::big_to_native<double>(p, sizeof(buf));
                 break;
             }
             default:
@@ -229,6 +229,11 @@ private:
         buffer_.resize(buffer_length_);
         std::size_t count = source_.read(buffer_.data(), buffer_length_);
         buffer_.resize(static_cast<std::size_t>(count));
+        if (source_.is_error())
+        {
+            ec = csv_errc::source_error;
+            return;
+        }
         if (buffer_.size() == 0)
         {
             eof_ = true;
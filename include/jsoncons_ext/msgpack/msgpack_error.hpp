@@ -24,7 +24,10 @@ enum class msgpack_errc
     too_few_items,
     max_nesting_depth_exceeded,
     length_is_negative,
-    unknown_type
+    unknown_type,
+    max_input_length_exceeded,
+    max_string_length_exceeded,
+    max_container_length_exceeded
 };
 
 class msgpack_error_category_impl
@@ -59,6 +62,12 @@ public:
                 return "Request for the length of an array, map or string returned a negative result";
             case msgpack_errc::unknown_type:
                 return "An unknown type was found in the stream";
+            case msgpack_errc::max_input_length_exceeded:
+                return "Input length exceeds limit in options";
+            case msgpack_errc::max_string_length_exceeded:
+                return "String length exceeds limit in options";
+            case msgpack_errc::max_container_length_exceeded:
+                return "Array or map length exceeds limit in options";
             default:
                 return "Unknown MessagePack parser error";
         }
@@ -43,9 +43,34 @@ public:
 class msgpack_decode_options : public virtual msgpack_options_common
 {
     friend class msgpack_options;
+
+    std::size_t max_input_length_;
+    std::size_t max_string_length_;
+    std::size_t max_container_length_;
 public:
     msgpack_decode_options()
+        : max_input_length_((std::numeric_limits<std::size_t>::max)()),
+          max_string_length_((std::numeric_limits<std::size_t>::max)()),
+          max_container_length_((std::numeric_limits<std::size_t>::max)())
+    {
+    }
+
+    // The maximum number of bytes read from the input
+    std::size_t max_input_length() const 
     {
+        return max_input_length_;
+    }
+
+    // The maximum length in bytes of a text string or byte string
+    std::size_t max_string_length() const 
+    {
+        return max_string_length_;
+    }
+
+    // The maximum number of items in an array or pairs in a map, as given by its header
+    std::size_t max_container_length() const 
+    {
+        return max_container_length_;
     }
 };
 
@@ -62,12 +87,33 @@ class msgpack_options final : public msgpack_decode_options, public msgpack_enco
 {
 public:
     using msgpack_options_common::max_nesting_depth;
+    using msgpack_decode_options::max_input_length;
+    using msgpack_decode_options::max_string_length;
+    using msgpack_decode_options::max_container_length;
 
     msgpack_options& max_nesting_depth(int value)
     {
         this->max_nesting_depth_ = value;
         return *this;
     }
+
+    msgpack_options& max_input_length(std::size_t value)
+    {
+        this->max_input_length_ = value;
+        return *this;
+    }
+
+    msgpack_options& max_string_length(std::size_t value)
+    {
+        this->max_string_length_ = value;
+        return *this;
+    }
+
+    msgpack_options& max_container_length(std::size_t value)
+    {
+        this->max_container_length_ = value;
+        return *this;
+    }
 };
 
 }}
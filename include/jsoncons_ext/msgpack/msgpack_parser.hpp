@@ -59,6 +59,7 @@ class basic_msgpack_parser : public ser_context
     std::vector<int64_t,int64_allocator_type> timestamp_buffer_;
     std::vector<parse_state,parse_state_allocator_type> state_stack_;
     int nesting_depth_;
+    std::size_t input_begin_;
 
 public:
     template <class Source>
@@ -74,6 +75,7 @@ public:
          state_stack_(alloc),
          nesting_depth_(0)
     {
+        input_begin_ = source_.position();
         state_stack_.emplace_back(parse_mode::root,0);
     }
 
@@ -88,6 +90,7 @@ public:
         state_stack_.emplace_back(parse_mode::root,0);
         more_ = true;
         done_ = false;
+        input_begin_ = source_.position();
     }
 
     bool done() const
@@ -114,76 +117,96 @@ public:
     {
         while (!done_ && more_)
         {
-            switch (state_stack_.back().mode)
+            parse_item(visitor, ec);
+            if (ec) return;
+        }
+    }
+
+    // Parses at most max_items data items, or the ends of arrays and maps, and
+    // returns the number parsed. If the parser is neither done nor stopped
+    // afterwards, a later call resumes where this one stopped.
+    std::size_t parse(json_visitor2& visitor, std::size_t max_items, std::error_code& ec)
+    {
+        std::size_t count = 0;
+        while (!done_ && more_ && count < max_items)
+        {
+            parse_item(visitor, ec);
+            ++count;
+            if (ec) break;
+        }
+        return count;
+    }
+private:
+    void parse_item(json_visitor2& visitor, std::error_code& ec)
+    {
+        switch (state_stack_.back().mode)
+        {
+            case parse_mode::array:
             {
-                case parse_mode::array:
+                if (state_stack_.back().index < state_stack_.back().length)
                 {
-                    if (state_stack_.back().index < state_stack_.back().length)
-                    {
-                        ++state_stack_.back().index;
-                        read_item(visitor, ec);
-                        if (ec)
-                        {
-                            return;
-                        }
-                    }
-                    else
+                    ++state_stack_.back().index;
+                    read_item(visitor, ec);
+                    if (ec)
                     {
-                        end_array(visitor, ec);
+                        return;
                     }
-                    break;
                 }
-                case parse_mode::map_key:
+                else
                 {
-                    if (state_stack_.back().index < state_stack_.back().length)
-                    {
-                        ++state_stack_.back().index;
-                        state_stack_.back().mode = parse_mode::map_value;
-                        read_item(visitor, ec);
-                        if (ec)
-                        {
-                            return;
-                        }
-                    }
-                    else
-                    {
-                        end_object(visitor, ec);
-                    }
-                    break;
+                    end_array(visitor, ec);
                 }
-                case parse_mode::map_value:
+                break;
+            }
+            case parse_mode::map_key:
+            {
+                if (state_stack_.back().index < state_stack_.back().length)
                 {
-                    state_stack_.back().mode = parse_mode::map_key;
+                    ++state_stack_.back().index;
+                    state_stack_.back().mode = parse_mode::map_value;
                     read_item(visitor, ec);
                     if (ec)
                     {
                         return;
                     }
-                    break;
                 }
-                case parse_mode::root:
+                else
                 {
-                    state_stack_.back().mode = parse_mode::before_done;
-                    read_item(visitor, ec);
-                    if (ec)
-                    {
-                        return;
-                    }
-                    break;
+                    end_object(visitor, ec);
+                }
+                break;
+            }
+            case parse_mode::map_value:
+            {
+                state_stack_.back().mode = parse_mode::map_key;
+                read_item(visitor, ec);
+                if (ec)
+                {
+                    return;
                 }
-                case parse_mode::before_done:
+                break;
+            }
+            case parse_mode::root:
+            {
+                state_stack_.back().mode = parse_mode::before_done;
+                read_item(visitor, ec);
+                if (ec)
                 {
-                    JSONCONS_ASSERT(state_stack_.size() == 1);
-                    state_stack_.clear();
-                    more_ = false;
-                    done_ = true;
-                    visitor.flush();
-                    break;
+                    return;
                 }
+                break;
+            }
+            case parse_mode::before_done:
+            {
+                JSONCONS_ASSERT(state_stack_.size() == 1);
+                state_stack_.clear();
+                more_ = false;
+                done_ = true;
+                visitor.flush();
+                break;
             }
         }
     }
-private:
 
     void read_item(json_visitor2& visitor, std::error_code& ec)
     {
@@ -193,6 +216,12 @@ private:
             more_ = false;
             return;
         }   
+        if (JSONCONS_UNLIKELY(input_read() > options_.max_input_length()))
+        {
+            ec = msgpack_errc::max_input_length_exceeded;
+            more_ = false;
+            return;
+        }
 
         auto ch = source_.get_character();
         if (!ch)
@@ -222,6 +251,10 @@ private:
             {
                 // fixstr
                 const size_t len = type & 0x1f;
+                if (!check_string_length(len, ec))
+                {
+                    return;
+                }
 
                 text_buffer_.clear();
 
@@ -269,13 +302,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::float32_cd: 
                 {
                     uint8_t buf[sizeof(float)];
-                    if (source_.read(buf, sizeof(float)) != sizeof(float))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(float));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    float val = jsoncons::detail::big_to_native<float>(buf, sizeof(buf));
+                    float val = jsoncons::detail::big_to_native<float>(p, sizeof(buf));
                     more_ = visitor.double_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -283,13 +317,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::float64_cd: 
                 {
                     uint8_t buf[sizeof(double)];
-                    if (source_.read(buf, sizeof(double)) != sizeof(double))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(double));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    double val = jsoncons::detail::big_to_native<double>(buf, sizeof(buf));
+                    double val = jsoncons::detail::big_to_native<double>(p, sizeof(buf));
                     more_ = visitor.double_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -310,13 +345,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::uint16_cd: 
                 {
                     uint8_t buf[sizeof(uint16_t)];
-                    if (source_.read(buf, sizeof(uint16_t)) !=sizeof(uint16_t)) 
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint16_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    uint16_t val = jsoncons::detail::big_to_native<uint16_t>(buf, sizeof(buf));
+                    uint16_t val = jsoncons::detail::big_to_native<uint16_t>(p, sizeof(buf));
                     more_ = visitor.uint64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -324,13 +360,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::uint32_cd: 
                 {
                     uint8_t buf[sizeof(uint32_t)];
-                    if (source_.read(buf, sizeof(uint32_t)) != sizeof(uint32_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint32_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    uint32_t val = jsoncons::detail::big_to_native<uint32_t>(buf, sizeof(buf));
+                    uint32_t val = jsoncons::detail::big_to_native<uint32_t>(p, sizeof(buf));
                     more_ = visitor.uint64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -338,13 +375,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::uint64_cd: 
                 {
                     uint8_t buf[sizeof(uint64_t)];
-                    if (source_.read(buf, sizeof(uint64_t)) != sizeof(uint64_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(uint64_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    uint64_t val = jsoncons::detail::big_to_native<uint64_t>(buf, sizeof(buf));
+                    uint64_t val = jsoncons::detail::big_to_native<uint64_t>(p, sizeof(buf));
                     more_ = visitor.uint64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -352,13 +390,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::int8_cd: 
                 {
                     uint8_t buf[sizeof(int8_t)];
-                    if (source_.read(buf, sizeof(int8_t)) != sizeof(int8_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int8_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    int8_t val = jsoncons::detail::big_to_native<int8_t>(buf, sizeof(buf));
+                    int8_t val = jsoncons::detail::big_to_native<int8_t>(p, sizeof(buf));
                     more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -366,13 +405,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::int16_cd: 
                 {
                     uint8_t buf[sizeof(int16_t)];
-                    if (source_.read(buf, sizeof(int16_t)) != sizeof(int16_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int16_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    int16_t val = jsoncons::detail::big_to_native<int16_t>(buf, sizeof(buf));
+                    int16_t val = jsoncons::detail::big_to_native<int16_t>(p, sizeof(buf));
                     more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -380,13 +420,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::int32_cd: 
                 {
                     uint8_t buf[sizeof(int32_t)];
-                    if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    int32_t val = jsoncons::detail::big_to_native<int32_t>(buf, sizeof(buf));
+                    int32_t val = jsoncons::detail::big_to_native<int32_t>(p, sizeof(buf));
                     more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -394,13 +435,14 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::int64_cd: 
                 {
                     uint8_t buf[sizeof(int64_t)];
-                    if (source_.read(buf, sizeof(int64_t)) != sizeof(int64_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int64_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
-                    int64_t val = jsoncons::detail::big_to_native<int64_t>(buf, sizeof(buf));
+                    int64_t val = jsoncons::detail::big_to_native<int64_t>(p, sizeof(buf));
                     more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                     break;
                 }
@@ -410,7 +452,7 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::str32_cd: 
                 {
                     std::size_t len = get_size(type, ec);
-                    if (!more_)
+                    if (!more_ || !check_string_length(len, ec))
                     {
                         return;
                     }
@@ -439,7 +481,7 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::bin32_cd: 
                 {
                     std::size_t len = get_size(type,ec);
-                    if (!more_)
+                    if (!more_ || !check_string_length(len, ec))
                     {
                         return;
                     }
@@ -467,21 +509,22 @@ private:
                 case jsoncons::msgpack::detail::msgpack_format::ext32_cd: 
                 {
                     std::size_t len = get_size(type,ec);
-                    if (!more_)
+                    if (!more_ || !check_string_length(len, ec))
                     {
                         return;
                     }
 
                     // type
                     uint8_t buf[sizeof(int8_t)];
-                    if (source_.read(buf, sizeof(int8_t)) != sizeof(int8_t))
+                    const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int8_t));
+                    if (p == nullptr)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
 
-                    int8_t ext_type = jsoncons::detail::big_to_native<int8_t>(buf, sizeof(buf));
+                    int8_t ext_type = jsoncons::detail::big_to_native<int8_t>(p, sizeof(buf));
 
                     semantic_tag tag{}; 
                     if (ext_type == -1)
@@ -596,7 +639,7 @@ private:
             return;
         } 
         std::size_t length = get_size(type, ec);
-        if (!more_)
+        if (!more_ || !check_container_length(length, ec))
         {
             return;
         }
@@ -621,7 +664,7 @@ private:
             return;
         } 
         std::size_t length = get_size(type, ec);
-        if (!more_)
+        if (!more_ || !check_container_length(length, ec))
         {
             return;
         }
@@ -636,6 +679,52 @@ private:
         state_stack_.pop_back();
     }
 
+    // Checks the length of an array or map, from its header, against the limits in
+    // the options. Each item takes at least one byte of input.
+    bool check_container_length(std::size_t length, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(length > options_.max_container_length()))
+        {
+            ec = msgpack_errc::max_container_length_exceeded;
+            more_ = false;
+            return false;
+        }
+        return check_input_length(length, ec);
+    }
+
+    // Checks the length of a string, byte string or extension payload, from its header,
+    // against the limits in the options before it is read
+    bool check_string_length(std::size_t length, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(length > options_.max_string_length()))
+        {
+            ec = msgpack_errc::max_string_length_exceeded;
+            more_ = false;
+            return false;
+        }
+        return check_input_length(length, ec);
+    }
+
+    // The number of bytes read since construction or the last reset, sources differ
+    // on whether position() starts at zero or one
+    std::size_t input_read() const
+    {
+        return source_.position() - input_begin_;
+    }
+
+    bool check_input_length(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = input_read();
+        if (JSONCONS_UNLIKELY(position > options_.max_input_length() || 
+                              length > options_.max_input_length() - position))
+        {
+            ec = msgpack_errc::max_input_length_exceeded;
+            more_ = false;
+            return false;
+        }
+        return true;
+    }
+
     std::size_t get_size(uint8_t type, std::error_code& ec)
     {
         switch (type)
@@ -645,13 +734,14 @@ private:
             case jsoncons::msgpack::detail::msgpack_format::ext8_cd: 
             {
                 uint8_t buf[sizeof(int8_t)];
-                if (source_.read(buf, sizeof(int8_t)) != sizeof(int8_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int8_t));
+                if (p == nullptr)
                 {
                     ec = msgpack_errc::unexpected_eof;
                     more_ = false;
                     return 0;
                 }
-                int8_t len = jsoncons::detail::big_to_native<int8_t>(buf, sizeof(buf));
+                int8_t len = jsoncons::detail::big_to_native<int8_t>(p, sizeof(buf));
                 if (len < 0)
                 {
                     ec = msgpack_errc::length_is_negative;
@@ -668,13 +758,14 @@ private:
             case jsoncons::msgpack::detail::msgpack_format::map16_cd:
             {
                 uint8_t buf[sizeof(int16_t)];
-                if (source_.read(buf, sizeof(int16_t)) != sizeof(int16_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int16_t));
+                if (p == nullptr)
                 {
                     ec = msgpack_errc::unexpected_eof;
                     more_ = false;
                     return 0;
                 }
-                int16_t len = jsoncons::detail::big_to_native<int16_t>(buf, sizeof(buf));
+                int16_t len = jsoncons::detail::big_to_native<int16_t>(p, sizeof(buf));
                 if (len < 0)
                 {
                     ec = msgpack_errc::length_is_negative;
@@ -691,13 +782,14 @@ private:
             case jsoncons::msgpack::detail::msgpack_format::map32_cd : 
             {
                 uint8_t buf[sizeof(int32_t)];
-                if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                if (p == nullptr)
                 {
                     ec = msgpack_errc::unexpected_eof;
                     more_ = false;
                     return 0;
                 }
-                int32_t len = jsoncons::detail::big_to_native<int32_t>(buf, sizeof(buf));
+                int32_t len = jsoncons::detail::big_to_native<int32_t>(p, sizeof(buf));
                 if (len < 0)
                 {
                     ec = msgpack_errc::length_is_negative;
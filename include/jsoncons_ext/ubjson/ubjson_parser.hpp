@@ -347,13 +347,14 @@ private:
             case jsoncons::ubjson::detail::ubjson_format::int8_type: 
             {
                 uint8_t buf[sizeof(int8_t)];
-                if (source_.read(buf, sizeof(int8_t)) != sizeof(int8_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int8_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                int8_t val = jsoncons::detail::big_to_native<int8_t>(buf, sizeof(buf));
+                int8_t val = jsoncons::detail::big_to_native<int8_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                 break;
             }
@@ -372,78 +373,84 @@ private:
             case jsoncons::ubjson::detail::ubjson_format::int16_type: 
             {
                 uint8_t buf[sizeof(int16_t)];
-                if (source_.read(buf, sizeof(int16_t)) != sizeof(int16_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int16_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                int16_t val = jsoncons::detail::big_to_native<int16_t>(buf, sizeof(buf));
+                int16_t val = jsoncons::detail::big_to_native<int16_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::ubjson::detail::ubjson_format::int32_type: 
             {
                 uint8_t buf[sizeof(int32_t)];
-                if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                int32_t val = jsoncons::detail::big_to_native<int32_t>(buf, sizeof(buf));
+                int32_t val = jsoncons::detail::big_to_native<int32_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::ubjson::detail::ubjson_format::int64_type: 
             {
                 uint8_t buf[sizeof(int64_t)];
-                if (source_.read(buf, sizeof(int64_t)) != sizeof(int64_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int64_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                int64_t val = jsoncons::detail::big_to_native<int64_t>(buf, sizeof(buf));
+                int64_t val = jsoncons::detail::big_to_native<int64_t>(p, sizeof(buf));
                 more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::ubjson::detail::ubjson_format::float32_type: 
             {
                 uint8_t buf[sizeof(float)];
-                if (source_.read(buf, sizeof(float)) != sizeof(float))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(float));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                float val = jsoncons::detail::big_to_native<float>(buf, sizeof(buf));
+                float val = jsoncons::detail::big_to_native<float>(p, sizeof(buf));
                 more_ = visitor.double_value(val, semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::ubjson::detail::ubjson_format::float64_type: 
             {
                 uint8_t buf[sizeof(double)];
-                if (source_.read(buf, sizeof(double)) != sizeof(double))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(double));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                double val = jsoncons::detail::big_to_native<double>(buf, sizeof(buf));
+                double val = jsoncons::detail::big_to_native<double>(p, sizeof(buf));
                 more_ = visitor.double_value(val, semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::ubjson::detail::ubjson_format::char_type: 
             {
                 uint8_t buf[sizeof(char)];
-                if (source_.read(buf, sizeof(char)) != sizeof(char))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(char));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                char c = jsoncons::detail::big_to_native<char>(buf, sizeof(buf));
+                char c = jsoncons::detail::big_to_native<char>(p, sizeof(buf));
                 auto result = unicons::validate(&c,&c+1);
                 if (result.ec != unicons::conv_errc())
                 {
@@ -723,13 +730,14 @@ private:
             case jsoncons::ubjson::detail::ubjson_format::int8_type: 
             {
                 uint8_t buf[sizeof(int8_t)];
-                if (source_.read(buf, sizeof(int8_t)) != sizeof(int8_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int8_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return length;
                 }
-                int8_t val = jsoncons::detail::big_to_native<int8_t>(buf, sizeof(buf));
+                int8_t val = jsoncons::detail::big_to_native<int8_t>(p, sizeof(buf));
                 if (val >= 0)
                 {
                     length = val;
@@ -757,13 +765,14 @@ private:
             case jsoncons::ubjson::detail::ubjson_format::int16_type: 
             {
                 uint8_t buf[sizeof(int16_t)];
-                if (source_.read(buf, sizeof(int16_t)) != sizeof(int16_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int16_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return length;
                 }
-                int16_t val = jsoncons::detail::big_to_native<int16_t>(buf, sizeof(buf));
+                int16_t val = jsoncons::detail::big_to_native<int16_t>(p, sizeof(buf));
                 if (val >= 0)
                 {
                     length = val;
@@ -779,13 +788,14 @@ private:
             case jsoncons::ubjson::detail::ubjson_format::int32_type: 
             {
                 uint8_t buf[sizeof(int32_t)];
-                if (source_.read(buf, sizeof(int32_t)) != sizeof(int32_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int32_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return length;
                 }
-                int32_t val = jsoncons::detail::big_to_native<int32_t>(buf, sizeof(buf));
+                int32_t val = jsoncons::detail::big_to_native<int32_t>(p, sizeof(buf));
                 if (val >= 0)
                 {
                     length = val;
@@ -801,13 +811,14 @@ private:
             case jsoncons::ubjson::detail::ubjson_format::int64_type: 
             {
                 uint8_t buf[sizeof(int64_t)];
-                if (source_.read(buf, sizeof(int64_t)) != sizeof(int64_t))
+                const uint8_t* p = source_reader<Src>::read_fixed(source_, buf, sizeof(int64_t));
+                if (p == nullptr)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return length;
                 }
-                int64_t val = jsoncons::detail::big_to_native<int64_t>(buf, sizeof(buf));
+                int64_t val = jsoncons::detail::big_to_native<int64_t>(p, sizeof(buf));
                 if (val >= 0)
                 {
                     length = (std::size_t)val;
@@ -0,0 +1,215 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/arena_allocator.hpp>
+#include <catch/catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_document(std::size_t n)
+    {
+        std::string s = "{\"items\":[";
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s.append("{\"id\":");
+            s.append(std::to_string(i));
+            s.append(",\"name\":\"A name long enough not to fit in a short string ");
+            s.append(std::to_string(i));
+            s.append("\",\"tags\":[\"a\",\"b\"],\"price\":1.5}");
+        }
+        s.append("]}");
+        return s;
+    }
+
+    template <class Json>
+    std::string to_string(const Json& j)
+    {
+        std::string s;
+        j.dump(s);
+        return s;
+    }
+
+} // namespace
+
+TEST_CASE("arena")
+{
+    SECTION("alignment")
+    {
+        arena a(64);
+        void* p1 = a.allocate(1, 1);
+        void* p2 = a.allocate(sizeof(double), alignof(double));
+        void* p3 = a.allocate(3, 1);
+        void* p4 = a.allocate(sizeof(std::uint64_t), alignof(std::uint64_t));
+        CHECK(p1 != p2);
+        CHECK(reinterpret_cast<std::uintptr_t>(p2) % alignof(double) == 0);
+        CHECK(p3 != p4);
+        CHECK(reinterpret_cast<std::uintptr_t>(p4) % alignof(std::uint64_t) == 0);
+        CHECK(a.allocated() == 1 + sizeof(double) + 3 + sizeof(std::uint64_t));
+    }
+    SECTION("alignment past the end of a chunk")
+    {
+        arena a(100);
+        a.allocate(82, 1);
+        char* p = static_cast<char*>(a.allocate(8, 8));
+        std::fill(p, p+8, 'a');
+        CHECK(reinterpret_cast<std::uintptr_t>(p) % 8 == 0);
+        CHECK(a.capacity() % alignof(std::max_align_t) == 0);
+
+        // Count the bytes that the first chunk of another arena holds
+        arena probe(100);
+        probe.allocate(1, 1);
+        std::size_t first_capacity = probe.capacity();
+        std::size_t n = 1;
+        while (probe.allocate(1, 1) != nullptr && probe.capacity() == first_capacity)
+        {
+            ++n;
+        }
+
+        // Leave one byte in the first chunk, then ask for more alignment than it gives
+        arena b(100);
+        b.allocate(n - 1, 1);
+        CHECK(b.capacity() == first_capacity);
+        char* q = static_cast<char*>(b.allocate(8, 64));
+        std::fill(q, q+8, 'b');
+        CHECK(reinterpret_cast<std::uintptr_t>(q) % 64 == 0);
+        CHECK(b.capacity() > first_capacity);
+    }
+    SECTION("allocation larger than a chunk")
+    {
+        arena a(64);
+        char* p = static_cast<char*>(a.allocate(1000, 1));
+        std::fill(p, p+1000, 'a');
+        CHECK(a.capacity() >= 1000);
+        char* q = static_cast<char*>(a.allocate(10, 1));
+        std::fill(q, q+10, 'b');
+        CHECK(p[999] == 'a');
+    }
+    SECTION("requests too large for a chunk")
+    {
+        const std::size_t max_size = (std::numeric_limits<std::size_t>::max)();
+        arena a(64);
+        a.allocate(8, 8);
+        CHECK_THROWS_AS(a.allocate(max_size - 8, 8), std::bad_alloc);
+        CHECK_THROWS_AS(a.allocate(max_size, 1), std::bad_alloc);
+        CHECK_THROWS_AS(a.allocate(max_size/2 + 1, 1), std::bad_alloc);
+        CHECK_THROWS_AS(a.allocate(8, max_size), std::bad_alloc);
+        CHECK(a.allocated() == 8);
+
+        // The arena is still usable
+        char* p = static_cast<char*>(a.allocate(16, 8));
+        std::fill(p, p+16, 'a');
+        CHECK(a.allocated() == 24);
+
+        arena_allocator<std::uint64_t> alloc(a);
+        CHECK_THROWS_AS(alloc.allocate(max_size/4 + 1), std::bad_alloc);
+        CHECK_THROWS_AS(arena_allocator<std::uint64_t>().allocate(max_size/4 + 1), std::bad_alloc);
+    }
+    SECTION("release")
+    {
+        arena a;
+        for (int i = 0; i < 10000; ++i)
+        {
+            a.allocate(16, 8);
+        }
+        CHECK(a.allocated() == 160000);
+        CHECK(a.capacity() >= a.allocated());
+        a.release();
+        CHECK(a.allocated() == 0);
+        CHECK(a.capacity() == 0);
+        a.allocate(16, 8);
+        CHECK(a.allocated() == 16);
+    }
+}
+
+TEST_CASE("arena_allocator")
+{
+    arena a;
+    arena_allocator<char> alloc1(a);
+    arena_allocator<double> alloc2(alloc1);
+    CHECK(alloc1 == alloc2);
+    CHECK(alloc2.get_arena() == &a);
+    CHECK(alloc1 != arena_allocator<char>());
+
+    std::vector<int,arena_allocator<int>> v(alloc1);
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(i);
+    }
+    CHECK(v[999] == 999);
+    CHECK(a.allocated() >= 1000*sizeof(int));
+
+    // Without an arena, the global heap is used
+    std::vector<int,arena_allocator<int>> w;
+    w.push_back(1);
+    CHECK(w[0] == 1);
+}
+
+TEST_CASE("json_decoder<arena_json>")
+{
+    std::string input = make_document(100);
+    json expected = json::parse(input);
+
+    SECTION("arena_json")
+    {
+        arena a;
+        {
+            json_decoder<arena_json> decoder(result_allocator_arg, arena_allocator<char>(a));
+            json_reader reader(input, decoder);
+            reader.read();
+            REQUIRE(decoder.is_valid());
+            arena_json j = decoder.get_result();
+
+            CHECK(j["items"].size() == 100);
+            CHECK(j["items"][99]["name"].as<std::string>() == "A name long enough not to fit in a short string 99");
+            CHECK(j.get_allocator() == arena_allocator<char>(a));
+            CHECK(to_string(j) == to_string(expected));
+
+            arena_json copy = j;
+            CHECK(copy == j);
+            copy["items"][0]["id"] = 1000;
+            CHECK(j["items"][0]["id"].as<int>() == 0);
+            CHECK(a.allocated() > input.size());
+        }
+        a.release();
+        CHECK(a.allocated() == 0);
+    }
+    SECTION("arena_ojson")
+    {
+        arena a;
+        json_decoder<arena_ojson> decoder(result_allocator_arg, arena_allocator<char>(a));
+        json_reader reader(input, decoder);
+        reader.read();
+        REQUIRE(decoder.is_valid());
+        arena_ojson j = decoder.get_result();
+
+        CHECK(j["items"][0].object_range().begin()->key() == "id");
+        CHECK(to_string(j) == to_string(ojson::parse(input)));
+    }
+    SECTION("reuse the arena")
+    {
+        arena a;
+        for (int i = 0; i < 3; ++i)
+        {
+            {
+                json_decoder<arena_json> decoder(result_allocator_arg, arena_allocator<char>(a));
+                json_reader reader(input, decoder);
+                reader.read();
+                arena_json j = decoder.get_result();
+                CHECK(j["items"].size() == 100);
+            }
+            a.release();
+        }
+    }
+}
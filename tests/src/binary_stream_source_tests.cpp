@@ -0,0 +1,228 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_bytes(std::size_t n)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            s.push_back(static_cast<char>(i % 251));
+        }
+        return s;
+    }
+
+    // Behaves like the read end of a pipe: it cannot seek, and it hands out only
+    // the chunks written so far. A read past them would block, and is recorded.
+    class pipe_streambuf : public std::streambuf
+    {
+        std::vector<std::string> chunks_;
+        std::size_t next_;
+        std::string current_;
+        bool closed_;
+    public:
+        bool would_block;
+
+        pipe_streambuf()
+            : next_(0), closed_(false), would_block(false)
+        {
+        }
+
+        void write(const std::string& s)
+        {
+            chunks_.push_back(s);
+        }
+
+        void close()
+        {
+            closed_ = true;
+        }
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+            if (next_ == chunks_.size())
+            {
+                if (!closed_)
+                {
+                    would_block = true;
+                }
+                return traits_type::eof();
+            }
+            current_ = chunks_[next_++];
+            setg(&current_[0], &current_[0], &current_[0] + current_.size());
+            return traits_type::to_int_type(*gptr());
+        }
+    };
+}
+
+TEST_CASE("binary_stream_source tests")
+{
+    std::string input = make_bytes(100);
+
+    SECTION("get, peek and ignore")
+    {
+        for (std::size_t buffer_size : {1, 3, 7, 16384})
+        {
+            std::istringstream is(input);
+            binary_stream_source source(is, buffer_size);
+            for (std::size_t i = 0; i < 50; ++i)
+            {
+                auto c = source.peek_character();
+                REQUIRE(c);
+                CHECK(c.value() == static_cast<uint8_t>(input[i]));
+                CHECK(source.get_character().value() == static_cast<uint8_t>(input[i]));
+            }
+            source.ignore(45);
+            CHECK(source.position() == 95);
+            CHECK(source.get_character().value() == static_cast<uint8_t>(input[95]));
+            CHECK_FALSE(source.eof());
+            source.ignore(10);
+            CHECK(source.eof());
+            CHECK_FALSE(source.get_character());
+        }
+    }
+    SECTION("read")
+    {
+        for (std::size_t buffer_size : {1, 3, 7, 16384})
+        {
+            std::istringstream is(input);
+            binary_stream_source source(is, buffer_size);
+            uint8_t buf[40];
+            CHECK(source.read(buf, 5) == 5);
+            CHECK(std::string(buf, buf+5) == input.substr(0, 5));
+            CHECK(source.read(buf, 40) == 40);
+            CHECK(std::string(buf, buf+40) == input.substr(5, 40));
+            CHECK_FALSE(source.eof());
+            CHECK(source.read(buf, 40) == 40);
+            CHECK(source.read(buf, 40) == 15);
+            CHECK(std::string(buf, buf+15) == input.substr(85));
+            CHECK(source.eof());
+            CHECK(source.position() == 100);
+        }
+    }
+    SECTION("read_view")
+    {
+        for (std::size_t buffer_size : {1, 3, 7, 16384})
+        {
+            std::istringstream is(input);
+            binary_stream_source source(is, buffer_size);
+            source.get_character();
+            auto s = source.read_view(8);
+            REQUIRE(s.size() == 8);
+            CHECK(std::string(s.data(), s.data()+8) == input.substr(1, 8));
+            s = source.read_view(60);
+            REQUIRE(s.size() == 60);
+            CHECK(std::string(s.data(), s.data()+60) == input.substr(9, 60));
+            CHECK_FALSE(source.eof());
+            s = source.read_view(40);
+            CHECK(s.size() == 31);
+            CHECK(source.eof());
+        }
+    }
+    SECTION("unread bytes are put back")
+    {
+        std::istringstream is(input);
+        {
+            binary_stream_source source(is, 64);
+            source.ignore(10);
+        }
+        CHECK(is.tellg() == 10);
+    }
+    SECTION("move")
+    {
+        std::istringstream is(input);
+        binary_stream_source source(is, 8);
+        source.ignore(3);
+        binary_stream_source source2(std::move(source));
+        CHECK(source2.get_character().value() == static_cast<uint8_t>(input[3]));
+        CHECK_FALSE(source.get_character());
+    }
+}
+
+TEST_CASE("binary_stream_source with binary readers")
+{
+    json expected = json::parse(R"(
+    {"a":[1,-2,300,-40000,5000000000,-6000000000,1.5,0.1,"seven",null,true,false],"b":{"c":"d","e":[]}}
+    )");
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        std::string s(data.begin(), data.end());
+        for (std::size_t buffer_size : {1, 2, 5, 16384})
+        {
+            std::istringstream is(s);
+            json_decoder<json> decoder;
+            cbor::basic_cbor_reader<binary_stream_source> reader(binary_stream_source(is, buffer_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("cbor values in sequence")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        cbor::encode_cbor(json("next"), data);
+        std::string s(data.begin(), data.end());
+
+        std::istringstream is(s);
+        CHECK(cbor::decode_cbor<json>(is) == expected);
+        CHECK(cbor::decode_cbor<json>(is) == json("next"));
+    }
+    SECTION("msgpack")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(expected, data);
+        std::string s(data.begin(), data.end());
+        for (std::size_t buffer_size : {1, 2, 5, 16384})
+        {
+            std::istringstream is(s);
+            json_decoder<json> decoder;
+            msgpack::basic_msgpack_reader<binary_stream_source> reader(binary_stream_source(is, buffer_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("cbor from a pipe")
+    {
+        pipe_streambuf buf;
+        std::istream is(&buf);
+        buf.write(std::string("\x01", 1));
+        CHECK(cbor::decode_cbor<json>(is) == json(1));
+        CHECK_FALSE(buf.would_block);
+
+        buf.write(std::string("\x02\x03", 2));
+        buf.close();
+        CHECK(cbor::decode_cbor<json>(is) == json(2));
+        CHECK(cbor::decode_cbor<json>(is) == json(3));
+    }
+    SECTION("truncated cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(json(5000000000), data);
+        std::string s(data.begin(), data.end()-1);
+        std::istringstream is(s);
+        std::error_code ec;
+        json_decoder<json> decoder;
+        cbor::cbor_stream_reader reader(is, decoder);
+        reader.read(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+}
@@ -304,3 +304,32 @@ TEST_CASE("json_visitor2 cbor 6")
     }
 }
 
+
+TEST_CASE("cbor_parser parse with a budget")
+{
+    json expected = json::parse(R"(
+        {"a":[1,-2,"three",[],{"b":null}],"c":true,"d":1.5}
+    )");
+    std::vector<uint8_t> input;
+    cbor::encode_cbor(expected, input);
+
+    for (std::size_t budget = 1; budget <= 3; ++budget)
+    {
+        json_decoder<json> destination;
+        json_visitor2_to_visitor_adaptor visitor{destination};
+
+        cbor::basic_cbor_parser<bytes_source> parser{ bytes_source(input) };
+
+        std::error_code ec;
+        std::size_t calls = 0;
+        while (!parser.done() && !parser.stopped())
+        {
+            std::size_t count = parser.parse(visitor, budget, ec);
+            REQUIRE_FALSE(ec);
+            CHECK(count <= budget);
+            ++calls;
+        }
+        CHECK(calls >= 16/budget);
+        CHECK(destination.get_result() == expected);
+    }
+}
@@ -0,0 +1,247 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/compressed_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+#if defined(JSONCONS_HAS_ZLIB) || defined(JSONCONS_HAS_ZSTD)
+
+namespace {
+
+    std::string make_text(std::size_t count)
+    {
+        std::string s = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s += "{\"id\":" + std::to_string(i) + ",\"name\":\"record-" + std::to_string(i) + "\"}";
+        }
+        s.push_back(']');
+        return s;
+    }
+}
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+namespace {
+
+    std::string gzip(const std::string& s)
+    {
+        z_stream strm = z_stream();
+        // 15 + 16 writes a gzip header
+        deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        std::string result(deflateBound(&strm, static_cast<uLong>(s.size())), '\0');
+        strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(s.data()));
+        strm.avail_in = static_cast<uInt>(s.size());
+        strm.next_out = reinterpret_cast<Bytef*>(&result[0]);
+        strm.avail_out = static_cast<uInt>(result.size());
+        deflate(&strm, Z_FINISH);
+        result.resize(strm.total_out);
+        deflateEnd(&strm);
+        return result;
+    }
+}
+
+TEST_CASE("gzip_source tests")
+{
+    std::string input = make_text(2000);
+    std::string compressed = gzip(input);
+
+    SECTION("get, peek, ignore and read")
+    {
+        std::istringstream is(compressed);
+        gzip_source<char> source(is, 64);
+
+        CHECK(source.peek_character().value() == input[0]);
+        CHECK(source.get_character().value() == input[0]);
+        source.ignore(100);
+        CHECK(source.position() == 101);
+        std::vector<char> buf(1000);
+        CHECK(source.read(buf.data(), buf.size()) == 1000);
+        CHECK(std::string(buf.data(), buf.size()) == input.substr(101, 1000));
+        auto s = source.read_view(300);
+        REQUIRE(s.size() == 300);
+        CHECK(std::string(s.data(), s.size()) == input.substr(1101, 300));
+
+        std::string rest;
+        while (!source.eof())
+        {
+            std::size_t n = source.read(buf.data(), buf.size());
+            rest.append(buf.data(), n);
+        }
+        CHECK(rest == input.substr(1401));
+        CHECK_FALSE(source.is_error());
+    }
+    SECTION("concatenated members")
+    {
+        std::istringstream is(gzip("[1,2,") + gzip("3]"));
+        json_decoder<json> decoder;
+        basic_json_reader<char,gzip_source<char>> reader(gzip_source<char>(is), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse("[1,2,3]"));
+    }
+    SECTION("truncated")
+    {
+        std::istringstream is(compressed.substr(0, compressed.size()/2));
+        json_decoder<json> decoder;
+        basic_json_reader<char,gzip_source<char>> reader(gzip_source<char>(is, 256), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+    SECTION("corrupt")
+    {
+        std::string s = compressed;
+        for (std::size_t i = 100; i < 200; ++i)
+        {
+            s[i] = 'x';
+        }
+        std::istringstream is(s);
+        gzip_source<char> source(is);
+        std::vector<char> buf(input.size());
+        source.read(buf.data(), buf.size());
+        CHECK(source.eof());
+        CHECK(source.is_error());
+    }
+}
+
+TEST_CASE("gzip_source with readers")
+{
+    std::string input = make_text(2000);
+    json expected = json::parse(input);
+
+    SECTION("json_reader")
+    {
+        for (std::size_t block_size : {1, 100, 16384})
+        {
+            std::istringstream is(gzip(input));
+            json_decoder<json> decoder;
+            basic_json_reader<char,gzip_source<char>> reader(gzip_source<char>(is, block_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("json_cursor")
+    {
+        std::istringstream is(gzip(input));
+        basic_json_cursor<char,gzip_source<char>> cursor(gzip_source<char>(is, 100));
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() == staj_event_type::begin_object)
+            {
+                ++count;
+            }
+        }
+        CHECK(count == 2000);
+    }
+    SECTION("csv_reader")
+    {
+        std::string text = "a,b\n1,one\n2,two\n3,three\n";
+        std::istringstream is(gzip(text));
+        json_decoder<json> decoder;
+        auto options = csv::csv_options{}.assume_header(true);
+        csv::basic_csv_reader<char,gzip_source<char>> reader(gzip_source<char>(is, 4), decoder, options);
+        reader.read();
+        json j = decoder.get_result();
+        REQUIRE(j.size() == 3);
+        CHECK(j[2]["b"].as<std::string>() == "three");
+    }
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        for (std::size_t block_size : {1, 100, 16384})
+        {
+            std::istringstream is(gzip(std::string(data.begin(), data.end())));
+            json_decoder<json> decoder;
+            cbor::basic_cbor_reader<binary_gzip_source> reader(binary_gzip_source(is, block_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("msgpack")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(expected, data);
+        std::istringstream is(gzip(std::string(data.begin(), data.end())));
+        json_decoder<json> decoder;
+        msgpack::basic_msgpack_reader<binary_gzip_source> reader(binary_gzip_source(is, 100), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+}
+
+#endif // defined(JSONCONS_HAS_ZLIB)
+
+#if defined(JSONCONS_HAS_ZSTD)
+
+TEST_CASE("zstd_source with readers")
+{
+    std::string input = make_text(2000);
+    json expected = json::parse(input);
+
+    auto compress = [](const std::string& s) -> std::string
+    {
+        std::string result(ZSTD_compressBound(s.size()), '\0');
+        result.resize(ZSTD_compress(&result[0], result.size(), s.data(), s.size(), 3));
+        return result;
+    };
+
+    SECTION("json_reader")
+    {
+        for (std::size_t block_size : {1, 100, 16384})
+        {
+            std::istringstream is(compress(input));
+            json_decoder<json> decoder;
+            basic_json_reader<char,zstd_source<char>> reader(zstd_source<char>(is, block_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("concatenated frames")
+    {
+        std::istringstream is(compress("[1,2,") + compress("3]"));
+        json_decoder<json> decoder;
+        basic_json_reader<char,zstd_source<char>> reader(zstd_source<char>(is), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse("[1,2,3]"));
+    }
+    SECTION("truncated")
+    {
+        std::string compressed = compress(input);
+        std::istringstream is(compressed.substr(0, compressed.size()/2));
+        json_decoder<json> decoder;
+        basic_json_reader<char,zstd_source<char>> reader(zstd_source<char>(is, 256), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        std::istringstream is(compress(std::string(data.begin(), data.end())));
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_zstd_source> reader(binary_zstd_source(is, 100), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+}
+
+#endif // defined(JSONCONS_HAS_ZSTD)
+
+#endif // defined(JSONCONS_HAS_ZLIB) || defined(JSONCONS_HAS_ZSTD)
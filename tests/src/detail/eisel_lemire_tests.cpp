@@ -0,0 +1,145 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <catch/catch.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    bool same_bits(double a, double b)
+    {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    void check_against_strtod(const std::string& s)
+    {
+        double result = 0;
+        if (jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', result))
+        {
+            double expected = std::strtod(s.c_str(), nullptr);
+            INFO(s);
+            CHECK(same_bits(result, expected));
+        }
+    }
+}
+
+TEST_CASE("detail::decimal_to_double tests")
+{
+    SECTION("agrees with strtod")
+    {
+        std::vector<std::string> inputs = {
+            "0", "-0", "0.0", "-0.0", "1", "-1", "0.1", "0.3", "1.7976931348623157e308",
+            "2.2250738585072014e-308", "4.9406564584124654e-324", "1e23", "8.589973e9",
+            "9007199254740993", "9007199254740992", "123456789012345678", "1234567890123456789",
+            "0.000000000000000000000000000000001", "7.3177701707893310e+15", "1e-400", "1e400",
+            "-1e400", "2.4703282292062327e-324", "1.00000000000000011102230246251565404236316680908203125",
+            "9223372036854775807", "18446744073709551615", "1.15507e-173", "1.15507e+173",
+            "-73.9864", "40.7484", "0.00000000000000000000000000000000000000000000000000000000000000000000000001",
+            "4.35679e-76", "1.7e-314", "1e22", "1e-22", "123e-22", "3.4028234663852886e38"
+        };
+        for (const auto& s : inputs)
+        {
+            check_against_strtod(s);
+        }
+    }
+
+    SECTION("generated values")
+    {
+        uint64_t x = 88172645463325252ull;
+        char buffer[64];
+        for (std::size_t i = 0; i < 20000; ++i)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            int exponent = static_cast<int>(x % 640) - 320;
+            unsigned long long mantissa = x >> (x % 48);
+            snprintf(buffer, sizeof(buffer), "%llue%d", mantissa, exponent);
+            check_against_strtod(buffer);
+            snprintf(buffer, sizeof(buffer), "-%llu.%llue%d", mantissa % 1000, mantissa, exponent/8);
+            check_against_strtod(buffer);
+        }
+    }
+
+    SECTION("round trips shortest representations")
+    {
+        uint64_t x = 2463534242ull;
+        char buffer[64];
+        for (std::size_t i = 0; i < 20000; ++i)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            double d;
+            std::memcpy(&d, &x, sizeof(double));
+            if (std::isnan(d) || std::isinf(d))
+            {
+                continue;
+            }
+            snprintf(buffer, sizeof(buffer), "%.17g", d);
+            check_against_strtod(buffer);
+        }
+    }
+
+    SECTION("falls back for input it does not handle")
+    {
+        std::vector<std::string> inputs = {
+            "", "-", "1.", ".5", "1e", "1e+", "+1", " 1", "1 ", "0x10", "inf", "nan",
+            "12345678901234567890", "1.2345678901234567890"
+        };
+        for (const auto& s : inputs)
+        {
+            double result = 0;
+            CHECK_FALSE(jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', result));
+        }
+    }
+
+    SECTION("leading zeros are not significant")
+    {
+        std::string s = "0.00000000000000000000000001234567890123456789";
+        double result = 0;
+        CHECK(jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', result));
+        CHECK(same_bits(result, std::strtod(s.c_str(), nullptr)));
+    }
+
+    SECTION("decimal point")
+    {
+        std::string s = "3,25";
+        double result = 0;
+        CHECK(jsoncons::detail::decimal_to_double(s.data(), s.length(), ',', result));
+        CHECK(result == 3.25);
+        CHECK_FALSE(jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', result));
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring s = L"-12.5e-1";
+        double result = 0;
+        CHECK(jsoncons::detail::decimal_to_double(s.data(), s.length(), L'.', result));
+        CHECK(result == -1.25);
+    }
+}
+
+TEST_CASE("to_double_t with digits past 19")
+{
+    jsoncons::detail::to_double_t to_double;
+
+    std::string s = "3.14159265358979323846264338327950288";
+    CHECK(same_bits(to_double(s.c_str(), s.length()), std::strtod(s.c_str(), nullptr)));
+
+    json j = json::parse("[1.7976931348623157e308, 5e-324, -0.0, 0.1, 1e400]");
+    CHECK(same_bits(j[0].as<double>(), 1.7976931348623157e308));
+    CHECK(same_bits(j[1].as<double>(), 5e-324));
+    CHECK(same_bits(j[2].as<double>(), -0.0));
+    CHECK(same_bits(j[3].as<double>(), 0.1));
+    CHECK(std::isinf(j[4].as<double>()));
+}
@@ -0,0 +1,137 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <catch/catch.hpp>
+#include <jsoncons/detail/hash_index.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct member
+    {
+        std::string key_;
+        int value_;
+
+        member(const std::string& key, int value)
+            : key_(key), value_(value)
+        {
+        }
+
+        const std::string& key() const
+        {
+            return key_;
+        }
+    };
+
+    using index_type = jsoncons::detail::hash_index<std::allocator<char>>;
+    using string_view_type = jsoncons::string_view;
+
+    void check_all(const index_type& index, const std::vector<member>& members)
+    {
+        for (std::size_t i = 0; i < members.size(); ++i)
+        {
+            REQUIRE(index.find(members, string_view_type(members[i].key())) == i);
+        }
+        CHECK(index.find(members, string_view_type("missing")) == index_type::npos);
+    }
+
+} // namespace
+
+TEST_CASE("jsoncons::detail::hash_index slot width")
+{
+    std::vector<member> members;
+    index_type index;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        members.emplace_back("key" + std::to_string(i), i);
+        index.insert(members, members.size()-1);
+    }
+    CHECK(index.capacity() == 0);
+    check_all(index, members);
+
+    members.emplace_back("key8", 8);
+    index.insert(members, members.size()-1);
+    CHECK(index.capacity() == 16);
+    CHECK(index.slot_width() == 1);
+    check_all(index, members);
+
+    for (int i = 9; i < 1000; ++i)
+    {
+        members.emplace_back("key" + std::to_string(i), i);
+        index.insert(members, members.size()-1);
+    }
+    CHECK(index.slot_width() == 2);
+    CHECK(3*members.size() <= 2*index.capacity());
+    check_all(index, members);
+
+    for (int i = 1000; i < 50000; ++i)
+    {
+        members.emplace_back("key" + std::to_string(i), i);
+        index.insert(members, members.size()-1);
+    }
+    CHECK(index.slot_width() == 4);
+    check_all(index, members);
+}
+
+TEST_CASE("jsoncons::detail::hash_index insert and erase in the middle")
+{
+    std::vector<member> members;
+    index_type index;
+    for (int i = 0; i < 300; ++i)
+    {
+        std::size_t pos = members.size() / 2;
+        members.emplace(members.begin() + pos, "key" + std::to_string(i), i);
+        index.insert(members, pos);
+    }
+    check_all(index, members);
+
+    while (members.size() > 20)
+    {
+        std::size_t pos1 = members.size() / 3;
+        std::size_t pos2 = pos1 + 7;
+        index.erase(members, pos1, pos2);
+        members.erase(members.begin() + pos1, members.begin() + pos2);
+        check_all(index, members);
+    }
+    index.erase(members, 0, 15);
+    members.erase(members.begin(), members.begin() + 15);
+    CHECK(index.capacity() == 0);
+    check_all(index, members);
+}
+
+TEST_CASE("jsoncons::detail::hash_index build_unique")
+{
+    SECTION("small")
+    {
+        std::vector<member> members = {{"a",1},{"b",2},{"a",3},{"c",4},{"b",5}};
+        index_type index;
+        index.build_unique(members);
+        REQUIRE(members.size() == 3);
+        CHECK(members[0].key() == "a");
+        CHECK(members[0].value_ == 1);
+        CHECK(members[1].key() == "b");
+        CHECK(members[1].value_ == 2);
+        CHECK(members[2].key() == "c");
+        check_all(index, members);
+    }
+    SECTION("large")
+    {
+        std::vector<member> members;
+        for (int i = 0; i < 500; ++i)
+        {
+            members.emplace_back("key" + std::to_string(i % 200), i);
+        }
+        index_type index;
+        index.build_unique(members);
+        REQUIRE(members.size() == 200);
+        for (int i = 0; i < 200; ++i)
+        {
+            CHECK(members[i].value_ == i);
+        }
+        check_all(index, members);
+    }
+}
@@ -0,0 +1,229 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace jsoncons;
+
+TEST_CASE("detail::find_string_special tests")
+{
+    SECTION("no special characters")
+    {
+        for (std::size_t n = 0; n < 70; ++n)
+        {
+            std::string s(n, 'a');
+            bool non_ascii = false;
+            CHECK(jsoncons::detail::find_string_special(s.data(), s.data()+s.length(), non_ascii) == s.data()+s.length());
+        }
+    }
+    SECTION("special character at every position")
+    {
+        const char specials[] = {'\"', '\\', '\0', '\x01', '\n', '\x1f'};
+        for (char special : specials)
+        {
+            for (std::size_t n = 1; n < 70; ++n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    std::string s(n, 'a');
+                    s[i] = special;
+                    bool non_ascii = false;
+                    const char* p = jsoncons::detail::find_string_special(s.data(), s.data()+s.length(), non_ascii);
+                    CHECK(p == s.data()+i);
+                }
+            }
+        }
+    }
+    SECTION("bytes above 0x7f are not special")
+    {
+        std::string s = "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\x20\x7f\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\"";
+        bool non_ascii = false;
+        const char* p = jsoncons::detail::find_string_special(s.data(), s.data()+s.length(), non_ascii);
+        CHECK(p == s.data()+s.length()-1);
+        CHECK(non_ascii);
+    }
+    SECTION("non ascii characters after the special character are not reported")
+    {
+        for (std::size_t n = 1; n < 70; ++n)
+        {
+            for (std::size_t i = 0; i+1 < n; ++i)
+            {
+                std::string s(n, '\xe9');
+                std::fill(s.begin(), s.begin()+i, 'a');
+                s[i] = '\\';
+                bool non_ascii = false;
+                const char* p = jsoncons::detail::find_string_special(s.data(), s.data()+s.length(), non_ascii);
+                CHECK(p == s.data()+i);
+                CHECK_FALSE(non_ascii);
+            }
+        }
+    }
+    SECTION("wide characters")
+    {
+        std::wstring s = L"abcdefghijklmnopqrstuvwxyz\\";
+        bool non_ascii = false;
+        const wchar_t* p = jsoncons::detail::find_string_special(s.data(), s.data()+s.length(), non_ascii);
+        CHECK(p == s.data()+s.length()-1);
+    }
+}
+
+TEST_CASE("detail::skip_whitespace tests")
+{
+    SECTION("agrees with the scalar version")
+    {
+        const char chars[] = {' ', '\t', '\n', 'x'};
+        for (std::size_t n = 0; n < 300; ++n)
+        {
+            std::string s;
+            std::size_t k = n;
+            for (std::size_t i = 0; i < 70; ++i)
+            {
+                s.push_back(i < 60 && (k % 7) != 0 ? chars[k % 3] : chars[3]);
+                k = k*31 + 17;
+            }
+
+            std::size_t lines1 = 0;
+            const char* line_start1 = nullptr;
+            const char* p1 = jsoncons::detail::skip_whitespace(s.data(), s.data()+s.length(), lines1, line_start1);
+
+            std::size_t lines2 = 0;
+            const char* line_start2 = nullptr;
+            const char* p2 = jsoncons::detail::skip_whitespace<char>(s.data(), s.data()+s.length(), lines2, line_start2);
+
+            CHECK(p1 == p2);
+            CHECK(lines1 == lines2);
+            CHECK(line_start1 == line_start2);
+        }
+    }
+    SECTION("indentation")
+    {
+        std::string s = "\n" + std::string(40, ' ') + "\n" + std::string(20, ' ') + "\t}";
+
+        std::size_t lines = 0;
+        const char* line_start = nullptr;
+        const char* p = jsoncons::detail::skip_whitespace(s.data(), s.data()+s.length(), lines, line_start);
+        CHECK(p == s.data()+s.length()-1);
+        CHECK(lines == 2);
+        CHECK(line_start == s.data()+42);
+    }
+}
+
+TEST_CASE("detail::validate_utf tests")
+{
+    std::vector<std::string> inputs = {
+        "",
+        "abcdefghijklmnopqrstuvwxyz0123456789",
+        "abcdefghijklmnopqrstuvwxyz0123456789\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e",
+        "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e abcdefghijklmnopqrstuvwxyz0123456789",
+        "abcdefghijklmnopqrstuvwxyz0123456789\xff",
+        "abcdefghijklmnopqrstuvwxyz0123456789\xc3",
+        "abcdefghijklmnopqrstuvwxyz0123456789\xc0\x80 abc",
+        "abcdefghijklmnopqrstuvwxyz0123456789\xed\xa0\x80",
+        "abcdefghijklmnopqrstuvwxyz0123456789\xf0\x9f\x98\x80 abcdefghijklmnop\x80",
+    };
+    for (const auto& s : inputs)
+    {
+        auto expected = unicons::validate(s.data(), s.data()+s.length());
+        auto result = jsoncons::detail::validate_utf(s.data(), s.data()+s.length());
+        CHECK(result.ec == expected.ec);
+        CHECK(result.it == expected.it);
+    }
+}
+
+TEST_CASE("json_parser indentation tests")
+{
+    SECTION("line and column after indentation")
+    {
+        std::string input = "{\n" + std::string(40, ' ') + "\"a\" : 1,\n\n" + std::string(36, ' ') + "\t\"b\" : x}";
+
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::expected_value);
+        CHECK(reader.line() == 4);
+        CHECK(reader.column() == 44);
+    }
+    SECTION("indentation split across buffers")
+    {
+        std::string input = "[\n" + std::string(40, ' ') + "1,\n" + std::string(40, ' ') + "true\n]";
+
+        for (std::size_t split = 1; split < input.size(); ++split)
+        {
+            json_decoder<json> decoder;
+            json_parser parser;
+            parser.update(input.data(), split);
+            parser.parse_some(decoder);
+            parser.update(input.data()+split, input.size()-split);
+            parser.finish_parse(decoder);
+            parser.check_done();
+            CHECK(parser.line() == 4);
+
+            json j = decoder.get_result();
+            CHECK(j.size() == 2);
+        }
+    }
+}
+
+TEST_CASE("json_parser long string tests")
+{
+    SECTION("long string with escapes")
+    {
+        std::string expected(100, 'x');
+        expected[40] = '\"';
+        expected[77] = '\n';
+        std::string input = "[\"" + expected.substr(0,40) + "\\\"" + expected.substr(41,36) + "\\n" + expected.substr(78) + "\"]";
+
+        json j = json::parse(input);
+        CHECK(j[0].as<std::string>() == expected);
+    }
+    SECTION("control character in long string")
+    {
+        std::string input = "\"" + std::string(50, 'x') + "\x01" + "\"";
+
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder, strict_json_parsing());
+        reader.read(ec);
+        CHECK(ec == json_errc::illegal_control_character);
+        CHECK(reader.column() == 53);
+    }
+    SECTION("invalid utf8 in long string")
+    {
+        std::string input = "[\"" + std::string(50, 'x') + "\xff" + "\"]";
+
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder, strict_json_parsing());
+        reader.read(ec);
+        CHECK(ec == json_errc::illegal_codepoint);
+    }
+    SECTION("non ascii string split across buffers")
+    {
+        std::string input = "[\"" + std::string(50, 'x') + "\xe6\x97\xa5" + std::string(50, 'y') + "\"]";
+
+        for (std::size_t split = 1; split < input.size(); ++split)
+        {
+            json_decoder<json> decoder;
+            json_parser parser;
+            parser.update(input.data(), split);
+            parser.parse_some(decoder);
+            parser.update(input.data()+split, input.size()-split);
+            parser.finish_parse(decoder);
+            parser.check_done();
+
+            json j = decoder.get_result();
+            CHECK(j[0].as<std::string>() == input.substr(2, input.size()-4));
+        }
+    }
+    SECTION("escaped non ascii character")
+    {
+        json j = json::parse("\"" + std::string(50, 'x') + "\\u00e9\"");
+        CHECK(j.as<std::string>() == std::string(50, 'x') + "\xc3\xa9");
+    }
+}
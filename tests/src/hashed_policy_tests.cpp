@@ -0,0 +1,153 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using hjson = basic_json<char,hashed_policy>;
+    using whjson = basic_json<wchar_t,hashed_policy>;
+
+    template <class Json>
+    std::string to_string(const Json& j)
+    {
+        std::string s;
+        j.dump(s);
+        return s;
+    }
+
+} // namespace
+
+TEST_CASE("hashed_policy parse and serialize")
+{
+    std::string input = R"({"c":1,"a":[true,{"z":null,"y":"A string too long for the short string optimization"}],"b":-1.5,"a":2})";
+
+    hjson j = hjson::parse(input);
+    CHECK(j.size() == 3);
+    CHECK(j["a"][1]["y"].as<std::string>() == "A string too long for the short string optimization");
+    CHECK(j.object_range().begin()->key() == "c");
+    CHECK(to_string(j) == to_string(ojson::parse(input)));
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+    CHECK(cbor::decode_cbor<hjson>(data) == j);
+
+    whjson wj = whjson::parse(L"{\"x\":1,\"y\":2}");
+    CHECK(wj[L"y"].as<int>() == 2);
+}
+
+TEST_CASE("hashed_policy large object")
+{
+    const int n = 20000;
+    hjson j(json_object_arg);
+    for (int i = 0; i < n; ++i)
+    {
+        j.try_emplace(std::to_string(i), i);
+    }
+    CHECK(j.size() == n);
+    for (int i = 0; i < n; ++i)
+    {
+        REQUIRE(j.contains(std::to_string(i)));
+        CHECK(j[std::to_string(i)].as<int>() == i);
+    }
+    CHECK_FALSE(j.contains("-1"));
+
+    for (int i = 0; i < n; i += 2)
+    {
+        j.erase(std::to_string(i));
+    }
+    CHECK(j.size() == n/2);
+    for (int i = 0; i < n; ++i)
+    {
+        CHECK(j.contains(std::to_string(i)) == (i % 2 == 1));
+    }
+    CHECK(j.object_range().begin()->key() == "1");
+
+    hjson k = hjson::parse(to_string(j));
+    CHECK(k == j);
+}
+
+TEST_CASE("hashed_policy agrees with preserve_order_policy")
+{
+    std::mt19937 gen(2020);
+    std::uniform_int_distribution<int> key_dist(0, 200);
+    std::uniform_int_distribution<int> op_dist(0, 5);
+
+    hjson h(json_object_arg);
+    ojson o(json_object_arg);
+    for (int step = 0; step < 3000; ++step)
+    {
+        std::string key = "k" + std::to_string(key_dist(gen));
+        switch (op_dist(gen))
+        {
+            case 0:
+                h.insert_or_assign(key, step);
+                o.insert_or_assign(key, step);
+                break;
+            case 1:
+                h.try_emplace(key, step);
+                o.try_emplace(key, step);
+                break;
+            case 2:
+            {
+                std::size_t pos = h.size() / 2;
+                h.try_emplace(h.object_range().begin() + pos, key, step);
+                o.try_emplace(o.object_range().begin() + pos, key, step);
+                break;
+            }
+            case 3:
+            {
+                std::size_t pos = h.size() / 3;
+                h.insert_or_assign(h.object_range().begin() + pos, key, step);
+                o.insert_or_assign(o.object_range().begin() + pos, key, step);
+                break;
+            }
+            case 4:
+                h.erase(key);
+                o.erase(key);
+                break;
+            case 5:
+                if (step % 7 == 0 && h.size() > 4)
+                {
+                    std::size_t pos = h.size() / 4;
+                    h.erase(h.object_range().begin() + pos, h.object_range().begin() + pos + 3);
+                    o.erase(o.object_range().begin() + pos, o.object_range().begin() + pos + 3);
+                }
+                break;
+        }
+        REQUIRE(h.size() == o.size());
+    }
+    CHECK(to_string(h) == to_string(o));
+    for (const auto& member : o.object_range())
+    {
+        REQUIRE(h.contains(member.key()));
+        CHECK(h[member.key()] == hjson::parse(to_string(member.value())));
+    }
+}
+
+TEST_CASE("hashed_policy comparison")
+{
+    hjson a = hjson::parse(R"({"a":1,"b":[1,2],"c":{"d":true}})");
+    hjson b = hjson::parse(R"({"c":{"d":true},"b":[1,2],"a":1})");
+    hjson c = hjson::parse(R"({"c":{"d":true},"b":[1,2],"a":2})");
+
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK_FALSE(a < b);
+    CHECK_FALSE(b < a);
+    CHECK(a < c);
+    CHECK_FALSE(c < a);
+
+    hjson copy = a;
+    copy.merge_or_update(c);
+    CHECK(copy == c);
+    copy.erase(copy.object_range().begin(), copy.object_range().end());
+    CHECK(copy.empty());
+}
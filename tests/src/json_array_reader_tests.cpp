@@ -0,0 +1,162 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_array_reader.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_array(std::size_t count)
+    {
+        std::string input = "[\n";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                input += ",\n";
+            }
+            input += "  {\"id\":" + std::to_string(i) + ",\"name\":\"a, [b] \\\"c\\\" {d}\",\"values\":[" + std::to_string(i) + ".5,[],{}]}";
+        }
+        input += "\n]\n";
+        return input;
+    }
+
+    struct parse_result
+    {
+        json value;
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+    };
+
+    parse_result parse_serially(const std::string& input, const json_options& options = json_options())
+    {
+        parse_result result;
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder, options);
+        reader.read(result.ec);
+        result.line = reader.line();
+        result.column = reader.column();
+        if (!result.ec)
+        {
+            result.value = decoder.get_result();
+        }
+        return result;
+    }
+
+    void check_same_as_serial(const std::string& input, std::size_t thread_count, std::size_t chunk_size,
+                              const json_options& options = json_options())
+    {
+        INFO(input);
+        parse_result expected = parse_serially(input, options);
+
+        std::error_code ec;
+        json_array_reader reader(input, options, thread_count, chunk_size);
+        json j = reader.read<json>(ec);
+        CHECK(ec == expected.ec);
+        if (expected.ec)
+        {
+            CHECK(reader.line() == expected.line);
+            CHECK(reader.column() == expected.column);
+        }
+        else
+        {
+            CHECK(j == expected.value);
+        }
+    }
+}
+
+TEST_CASE("json_array_reader same as serial")
+{
+    std::string input = make_array(300);
+    for (std::size_t thread_count : {1, 2, 4})
+    {
+        for (std::size_t chunk_size : {1, 100, 5000, 1000000})
+        {
+            check_same_as_serial(input, thread_count, chunk_size);
+        }
+    }
+}
+
+TEST_CASE("json_array_reader edge cases")
+{
+    std::vector<std::string> inputs = {
+        "[]", " [ ] ", "[1]", "[[1],[2]]", "[\"]\",\"\\\\\",\"\\\"\"]", "{\"a\":[1,2]}", "1", "\"[1,2]\"",
+        "[1,2] ", "[1,2]x", "[1,,2]", "[1,]", "[,1]", "[1 2]", "[1,{]", "[1,[2}]", "[1,2", "[\"abc]", "",
+        "[1, /* two */ 2]", "[1,tru]", "[1,\n {\"a\":}]", "[1]]", "[1}"
+    };
+    for (const auto& input : inputs)
+    {
+        check_same_as_serial(input, 3, 1);
+    }
+}
+
+TEST_CASE("json_array_reader options")
+{
+    json_options options;
+    options.max_nesting_depth(3)
+           .lossless_number(true);
+    check_same_as_serial("[[[1]],[2.5]]", 2, 1, options);
+    check_same_as_serial("[[[[1]]],[2.5]]", 2, 1, options);
+
+    std::string input = "[1,2,3,4,5,6,7,8,9,10]";
+    check_same_as_serial(input, 2, 1, json_options{}.max_input_length(10));
+    check_same_as_serial(input, 2, 1, json_options{}.max_input_length(input.size()));
+}
+
+TEST_CASE("json_array_reader many batches")
+{
+    std::string input = make_array(2000);
+    json expected = json::parse(input);
+
+    json_array_reader reader(input, json_options(), 4, 64);
+    CHECK(reader.read<json>() == expected);
+    CHECK(reader.read<json>() == expected);
+}
+
+TEST_CASE("json_array_reader read_elements")
+{
+    std::string input = make_array(100);
+    json expected = json::parse(input);
+
+    std::vector<json> values;
+    json_array_reader reader(input, json_options(), 3, 200);
+    reader.read_elements<json>([&](json&& j) {values.push_back(std::move(j));});
+    REQUIRE(values.size() == expected.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        CHECK(values[i] == expected[i]);
+    }
+
+    SECTION("error")
+    {
+        std::string bad = "[1,2,3,{\"a\" 4},5]";
+        std::vector<json> values2;
+        json_array_reader reader2(bad, json_options(), 2, 1);
+        REQUIRE_THROWS_AS(reader2.read_elements<json>([&](json&& j) {values2.push_back(std::move(j));}), ser_error);
+        CHECK(values2.size() <= 3);
+        CHECK(reader2.line() == 1);
+        CHECK(reader2.column() == 13);
+    }
+    SECTION("not an array")
+    {
+        std::string object = "{}";
+        json_array_reader reader2(object, json_options(), 2, 1);
+        std::error_code ec;
+        reader2.read_elements<json>([](json&&) {}, ec);
+        CHECK(ec == convert_errc::not_vector);
+        REQUIRE_THROWS_AS(reader2.read_elements<json>([](json&&) {}), ser_error);
+    }
+}
+
+TEST_CASE("wjson_array_reader")
+{
+    std::wstring input = L"[{\"a\":1},[\"\\u00e9\"],2.5]";
+    wjson_array_reader reader(input, wjson_options(), 2, 1);
+    CHECK(reader.read<wjson>() == wjson::parse(input));
+}
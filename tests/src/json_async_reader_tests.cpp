@@ -0,0 +1,203 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_async_reader.hpp>
+#include <catch/catch.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+#if defined(JSONCONS_HAS_COROUTINES)
+
+using namespace jsoncons;
+
+namespace {
+
+    // Runs suspended coroutines one at a time, in the order they were scheduled
+    class event_loop
+    {
+        std::deque<std::coroutine_handle<>> ready_;
+    public:
+        void schedule(std::coroutine_handle<> h)
+        {
+            ready_.push_back(h);
+        }
+
+        void run()
+        {
+            while (!ready_.empty())
+            {
+                auto h = ready_.front();
+                ready_.pop_front();
+                h.resume();
+            }
+        }
+    };
+
+    // Delivers a text in chunks of chunk_size characters. When an event loop is
+    // given, each read suspends the reader until the loop resumes it.
+    class chunked_source
+    {
+        std::string text_;
+        std::size_t chunk_size_;
+        std::size_t offset_;
+        event_loop* loop_;
+    public:
+        chunked_source(const std::string& text, std::size_t chunk_size, event_loop* loop = nullptr)
+            : text_(text), chunk_size_(chunk_size), offset_(0), loop_(loop)
+        {
+        }
+
+        struct awaiter
+        {
+            chunked_source* source;
+
+            bool await_ready() const noexcept
+            {
+                return source->loop_ == nullptr;
+            }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                source->loop_->schedule(h);
+            }
+
+            jsoncons::string_view await_resume()
+            {
+                std::size_t len = (std::min)(source->chunk_size_, source->text_.size() - source->offset_);
+                jsoncons::string_view s(source->text_.data() + source->offset_, len);
+                source->offset_ += len;
+                return s;
+            }
+        };
+
+        awaiter read_buffer()
+        {
+            return awaiter{this};
+        }
+    };
+
+    async_task<json> decode(chunked_source& source)
+    {
+        json_decoder<json> decoder;
+        json_async_reader<chunked_source> reader(source, decoder);
+        co_await reader.read();
+        co_return decoder.get_result();
+    }
+
+    async_task<std::vector<staj_event_type>> events(chunked_source& source)
+    {
+        std::vector<staj_event_type> result;
+        json_async_cursor<chunked_source> cursor(source);
+        co_await cursor.next();
+        while (!cursor.done())
+        {
+            result.push_back(cursor.current().event_type());
+            co_await cursor.next();
+        }
+        co_return result;
+    }
+}
+
+TEST_CASE("json_async_reader tests")
+{
+    std::string input = R"({"first":"café","second":[12345,-6.25e-3,true,false,null],"third":{"a":"b"}})";
+    json expected = json::parse(input);
+
+    SECTION("chunks that are ready")
+    {
+        for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size)
+        {
+            chunked_source source(input, chunk_size);
+            auto task = decode(source);
+            task.start();
+            REQUIRE(task.done());
+            CHECK(task.get() == expected);
+        }
+    }
+    SECTION("concurrent readers on an event loop")
+    {
+        event_loop loop;
+        std::vector<chunked_source> sources;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            sources.emplace_back(input, i % 7 + 1, &loop);
+        }
+        std::vector<async_task<json>> tasks;
+        for (auto& source : sources)
+        {
+            tasks.push_back(decode(source));
+            tasks.back().start();
+            CHECK_FALSE(tasks.back().done());
+        }
+        loop.run();
+        for (auto& task : tasks)
+        {
+            REQUIRE(task.done());
+            CHECK(task.get() == expected);
+        }
+    }
+    SECTION("parse error")
+    {
+        event_loop loop;
+        chunked_source source("[1,2,\n3,]", 2, &loop);
+        json_decoder<json> decoder;
+        json_async_reader<chunked_source> reader(source, decoder);
+        std::error_code ec;
+        auto task = reader.read(ec);
+        task.start();
+        loop.run();
+        REQUIRE(task.done());
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(reader.line() == 2);
+
+        chunked_source source2("[1,2,\n3,]", 2, &loop);
+        auto task2 = decode(source2);
+        task2.start();
+        loop.run();
+        REQUIRE(task2.done());
+        CHECK_THROWS_AS(task2.get(), ser_error);
+    }
+    SECTION("extra characters")
+    {
+        chunked_source source("[1,2] 3", 3);
+        auto task = decode(source);
+        task.start();
+        REQUIRE(task.done());
+        CHECK_THROWS_AS(task.get(), ser_error);
+    }
+}
+
+TEST_CASE("json_async_cursor tests")
+{
+    std::string input = R"(["one","two",[3,4.5],{"five":"six"}])";
+
+    std::vector<staj_event_type> expected;
+    json_cursor cursor(input);
+    for (; !cursor.done(); cursor.next())
+    {
+        expected.push_back(cursor.current().event_type());
+    }
+
+    event_loop loop;
+    std::vector<chunked_source> sources;
+    for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size)
+    {
+        sources.emplace_back(input, chunk_size, &loop);
+    }
+    std::vector<async_task<std::vector<staj_event_type>>> tasks;
+    for (auto& source : sources)
+    {
+        tasks.push_back(events(source));
+        tasks.back().start();
+    }
+    loop.run();
+    for (auto& task : tasks)
+    {
+        REQUIRE(task.done());
+        CHECK(task.get() == expected);
+    }
+}
+
+#endif // defined(JSONCONS_HAS_COROUTINES)
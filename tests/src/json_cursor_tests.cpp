@@ -576,3 +576,71 @@ TEST_CASE("staj event as object")
     }
 }
 
+
+TEST_CASE("json_cursor next with a budget")
+{
+    std::string input = R"([{"first":"Jane","last":"Roe","id":123456},{"first":"John","last":"Doe","id":78.5},null])";
+
+    std::vector<staj_event_type> expected;
+    for (json_cursor cursor(input); !cursor.done(); cursor.next())
+    {
+        expected.push_back(cursor.current().event_type());
+    }
+
+    SECTION("string source")
+    {
+        for (std::size_t budget = 1; budget <= 5; ++budget)
+        {
+            json_cursor cursor(input);
+            std::vector<staj_event_type> events;
+            std::size_t calls = 0;
+            while (!cursor.done())
+            {
+                events.push_back(cursor.current().event_type());
+                while (!cursor.next(budget))
+                {
+                    ++calls;
+                }
+                ++calls;
+            }
+            CHECK(events == expected);
+            CHECK(calls >= (input.size()-1)/budget);
+        }
+    }
+    SECTION("stream source")
+    {
+        std::istringstream is(input);
+        json_cursor cursor(is);
+        cursor.buffer_length(7);
+        std::vector<staj_event_type> events;
+        while (!cursor.done())
+        {
+            events.push_back(cursor.current().event_type());
+            while (!cursor.next(3))
+            {
+            }
+        }
+        CHECK(events == expected);
+    }
+    SECTION("string value")
+    {
+        json_cursor cursor(input);
+        cursor.next();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK_FALSE(cursor.next(4));
+        CHECK(cursor.next(4));
+        CHECK(cursor.current().event_type() == staj_event_type::string_value);
+        CHECK(cursor.current().get<std::string>() == "Jane");
+    }
+    SECTION("error")
+    {
+        json_cursor cursor(std::string("[1,]"));
+        std::error_code ec;
+        while (!ec && !cursor.done())
+        {
+            cursor.next(1, ec);
+        }
+        CHECK(ec == json_errc::extra_comma);
+    }
+}
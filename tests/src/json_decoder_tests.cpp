@@ -0,0 +1,106 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json_decoder builds values in place")
+{
+    SECTION("nested containers")
+    {
+        std::string input = R"({"b":[1,{"c":[[],{}],"a":null},"x"],"a":{"d":-1.5,"e":true}})";
+        json j = json::parse(input);
+        CHECK(j.size() == 2);
+        CHECK(j["b"].size() == 3);
+        CHECK(j["b"][1]["c"][0].is_array());
+        CHECK(j["b"][1]["c"][1].is_object());
+        CHECK(j["b"][1]["a"].is_null());
+        CHECK(j["b"][2].as<std::string>() == "x");
+        CHECK(j["a"]["d"].as<double>() == -1.5);
+        CHECK(j.object_range().begin()->key() == "a");
+
+        ojson oj = ojson::parse(input);
+        CHECK(oj.object_range().begin()->key() == "b");
+        CHECK(oj["b"][1].object_range().begin()->key() == "c");
+        CHECK(oj["b"][1]["c"][1].is_object());
+    }
+    SECTION("duplicate names keep the first")
+    {
+        std::string input = R"({"a":1,"b":2,"a":3,"c":{"x":1,"x":2}})";
+        json j = json::parse(input);
+        CHECK(j.size() == 3);
+        CHECK(j["a"].as<int>() == 1);
+        CHECK(j["c"].size() == 1);
+        CHECK(j["c"]["x"].as<int>() == 1);
+
+        ojson oj = ojson::parse(input);
+        CHECK(oj.size() == 3);
+        CHECK(oj["a"].as<int>() == 1);
+        CHECK(oj["c"]["x"].as<int>() == 1);
+    }
+    SECTION("scalar root")
+    {
+        CHECK(json::parse("\"A string too long for the short string optimization\"").as<std::string>() == "A string too long for the short string optimization");
+        CHECK(json::parse("-10").as<int>() == -10);
+    }
+    SECTION("decoder reuse")
+    {
+        json_decoder<json> decoder;
+        std::string input1 = R"({"a":[1,2]})";
+        json_reader reader1(input1, decoder);
+        reader1.read();
+        CHECK(decoder.get_result()["a"].size() == 2);
+
+        std::string input2 = R"([true,{"b":false}])";
+        json_reader reader2(input2, decoder);
+        reader2.read();
+        REQUIRE(decoder.is_valid());
+        json j = decoder.get_result();
+        CHECK(j.size() == 2);
+        CHECK_FALSE(j[1]["b"].as<bool>());
+    }
+}
+
+TEST_CASE("json_decoder length hints")
+{
+    SECTION("cbor")
+    {
+        json expected = json::parse(R"({"a":[1,2,3,4,5,6,7,8,9,10,11,12,13],"b":{"c":1,"d":2,"e":3}})");
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+
+        json j = cbor::decode_cbor<json>(data);
+        CHECK(j == expected);
+        CHECK(j.capacity() == 2);
+        CHECK(j["a"].capacity() == 13);
+        CHECK(j["b"].capacity() == 3);
+    }
+    SECTION("msgpack")
+    {
+        ojson expected = ojson::parse(R"({"b":[1,2,3,4,5,6,7,8,9,10,11,12,13],"a":{"d":1,"c":2,"e":3}})");
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(expected, data);
+
+        ojson j = msgpack::decode_msgpack<ojson>(data);
+        CHECK(j == expected);
+        CHECK(j["b"].capacity() == 13);
+        CHECK(j["a"].capacity() == 3);
+    }
+    SECTION("a hostile length is not trusted")
+    {
+        // An array header claiming 2^32-1 items, followed by one item
+        std::vector<uint8_t> data = {0x9a,0xff,0xff,0xff,0xff,0x01};
+        std::error_code ec;
+        json_decoder<json> decoder;
+        cbor::cbor_bytes_reader reader(data, decoder);
+        reader.read(ec);
+        CHECK(ec);
+        CHECK_FALSE(decoder.is_valid());
+    }
+}
@@ -55,3 +55,56 @@ TEST_CASE("test_integer_limits")
     }
 }
 
+
+TEST_CASE("json_parser integer accumulation")
+{
+    SECTION("boundaries")
+    {
+        json j = json::parse("[0,-0,9223372036854775807,-9223372036854775808,-9223372036854775809,18446744073709551615,18446744073709551616,184467440737095516150]");
+        REQUIRE(j.size() == 8);
+        CHECK(j[0].is_uint64());
+        CHECK(j[0].as<uint64_t>() == 0);
+        CHECK(j[1].is_int64());
+        CHECK(j[1].as<int64_t>() == 0);
+        CHECK(j[2].as<int64_t>() == (std::numeric_limits<int64_t>::max)());
+        CHECK(j[3].is_int64());
+        CHECK(j[3].as<int64_t>() == (std::numeric_limits<int64_t>::lowest)());
+        CHECK(j[4].tag() == semantic_tag::bigint);
+        CHECK(j[4].as<std::string>() == "-9223372036854775809");
+        CHECK(j[5].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(j[6].tag() == semantic_tag::bigint);
+        CHECK(j[6].as<std::string>() == "18446744073709551616");
+        CHECK(j[7].as<std::string>() == "184467440737095516150");
+    }
+    SECTION("fractions and exponents after accumulated digits")
+    {
+        json j = json::parse("[12345.5,-12345e2,0.25,-0e1,18446744073709551616.5,123E-2]");
+        CHECK(j[0].as<double>() == 12345.5);
+        CHECK(j[1].as<double>() == -1234500.0);
+        CHECK(j[2].as<double>() == 0.25);
+        CHECK(j[3].as<double>() == 0.0);
+        CHECK(j[4].as<double>() == 18446744073709551616.5);
+        CHECK(j[5].as<double>() == 1.23);
+    }
+    SECTION("numbers split across buffers")
+    {
+        std::string input = "[-123456789,18446744073709551617,-45.5e1,7]";
+        for (std::size_t split = 1; split < input.size(); ++split)
+        {
+            json_decoder<json> decoder;
+            json_parser parser;
+            parser.update(input.data(), split);
+            parser.parse_some(decoder);
+            parser.update(input.data()+split, input.size()-split);
+            parser.finish_parse(decoder);
+            parser.check_done();
+
+            json j = decoder.get_result();
+            REQUIRE(j.size() == 4);
+            CHECK(j[0].as<int64_t>() == -123456789);
+            CHECK(j[1].as<std::string>() == "18446744073709551617");
+            CHECK(j[2].as<double>() == -455.0);
+            CHECK(j[3].as<int>() == 7);
+        }
+    }
+}
@@ -0,0 +1,189 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_lines(std::size_t count)
+    {
+        std::string input;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            input += "{\"id\":" + std::to_string(i) + ",\"name\":\"item" + std::to_string(i) + "\",\"tags\":[1,2.5,null]}\n";
+            if (i % 7 == 3)
+            {
+                input += " \r\n";
+            }
+        }
+        return input;
+    }
+
+    std::vector<json> parse_serially(const std::string& input)
+    {
+        std::vector<json> values;
+        std::istringstream is(input);
+        std::string line;
+        while (std::getline(is, line))
+        {
+            if (line.find_first_not_of(" \t\r") != std::string::npos)
+            {
+                values.push_back(json::parse(line));
+            }
+        }
+        return values;
+    }
+}
+
+TEST_CASE("json_lines_reader in order")
+{
+    std::string input = make_lines(500);
+    std::vector<json> expected = parse_serially(input);
+    REQUIRE(expected.size() == 500);
+
+    for (std::size_t thread_count : {1, 2, 3, 8})
+    {
+        for (std::size_t chunk_size : {1, 50, 1000, 1000000})
+        {
+            INFO("threads " << thread_count << ", chunk size " << chunk_size);
+
+            std::vector<json> values;
+            json_lines_reader reader(input, json_options(), thread_count, chunk_size);
+            reader.read<json>([&](json&& j) {values.push_back(std::move(j));});
+            CHECK(values == expected);
+
+            std::istringstream is(input);
+            std::vector<json> values2;
+            json_lines_reader reader2(is, json_options(), thread_count, chunk_size);
+            reader2.read<json>([&](json&& j) {values2.push_back(std::move(j));});
+            CHECK(values2 == expected);
+        }
+    }
+}
+
+TEST_CASE("json_lines_reader reuse")
+{
+    std::string input = make_lines(500);
+    std::vector<json> expected = parse_serially(input);
+
+    json_lines_reader reader(input, json_options(), 4, 64);
+    for (int i = 0; i < 2; ++i)
+    {
+        std::vector<json> values;
+        reader.read<json>([&](json&& j) {values.push_back(std::move(j));});
+        CHECK(values == expected);
+    }
+}
+
+TEST_CASE("json_lines_reader max_input_length applies to each line")
+{
+    std::string input = "[1,2,3]\n[4,5]\n[6,7,8,9]\n";
+
+    std::vector<json> values;
+    json_lines_reader reader(input, json_options{}.max_input_length(7), 2, 1);
+    std::error_code ec;
+    reader.read<json>([&](json&& j) {values.push_back(std::move(j));}, ec);
+    CHECK(ec == json_errc::max_input_length_exceeded);
+    CHECK(reader.line() == 3);
+    CHECK(values.size() == 2);
+}
+
+TEST_CASE("json_lines_reader edge cases")
+{
+    std::vector<std::string> inputs = {"", "\n", "1", "1\n", "\n\n[1,2]\n\n", "\"a\"\r\n\"b\"", "{}\n{}\n{}"};
+    for (const auto& input : inputs)
+    {
+        INFO(input);
+        std::vector<json> values;
+        json_lines_reader reader(input, json_options(), 2, 1);
+        reader.read<json>([&](json&& j) {values.push_back(std::move(j));});
+        CHECK(values == parse_serially(input));
+    }
+}
+
+TEST_CASE("json_lines_reader errors")
+{
+    std::string input = make_lines(100) + "{\"id\":100,}\n" + make_lines(10);
+    std::size_t error_line = 0;
+    {
+        std::istringstream is(input);
+        std::string line;
+        while (std::getline(is, line))
+        {
+            ++error_line;
+            if (line == "{\"id\":100,}")
+            {
+                break;
+            }
+        }
+    }
+
+    for (std::size_t thread_count : {1, 4})
+    {
+        std::vector<json> values;
+        std::error_code ec;
+        json_lines_reader reader(input, json_options(), thread_count, 256);
+        reader.read<json>([&](json&& j) {values.push_back(std::move(j));}, ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(reader.line() == error_line);
+        CHECK(reader.column() == 11);
+        CHECK(values.size() == 100);
+
+        std::istringstream is(input);
+        json_lines_reader reader2(is, json_options(), thread_count, 256);
+        REQUIRE_THROWS_AS(reader2.read<json>([](json&&) {}), ser_error);
+        CHECK(reader2.line() == error_line);
+    }
+}
+
+TEST_CASE("json_lines_reader with visitors")
+{
+    std::string input = make_lines(200);
+    std::vector<json> expected = parse_serially(input);
+
+    std::vector<std::string> outputs(3);
+    std::vector<std::unique_ptr<json_string_encoder>> encoders;
+    std::vector<json_visitor*> visitors;
+    for (auto& output : outputs)
+    {
+        encoders.emplace_back(new json_string_encoder(output));
+        visitors.push_back(encoders.back().get());
+    }
+
+    json_lines_reader reader(input, json_options(), 0, 500);
+    reader.read(visitors);
+
+    // Every value is visited exactly once
+    std::size_t count = 0;
+    for (const auto& output : outputs)
+    {
+        count += output.empty() ? 0 : 1;
+    }
+    CHECK(count == 3);
+
+    std::string all = outputs[0] + outputs[1] + outputs[2];
+    std::size_t n = 0;
+    for (std::size_t pos = all.find("\"id\""); pos != std::string::npos; pos = all.find("\"id\"", pos+1))
+    {
+        ++n;
+    }
+    CHECK(n == expected.size());
+}
+
+TEST_CASE("wjson_lines_reader")
+{
+    std::wstring input = L"{\"a\":1}\n[\"\\u00e9\"]\n";
+    std::vector<wjson> values;
+    wjson_lines_reader reader(input, wjson_options(), 2);
+    reader.read<wjson>([&](wjson&& j) {values.push_back(std::move(j));});
+    REQUIRE(values.size() == 2);
+    CHECK(values[1][0].as<std::wstring>() == L"\u00e9");
+}
@@ -277,3 +277,122 @@ TEST_CASE("test_incremental_parsing")
 
 
 
+
+TEST_CASE("test_compact_state")
+{
+    SECTION("incremental values")
+    {
+        json_parser parser(compact_state_arg);
+        std::size_t initial = parser.footprint();
+        CHECK(initial < json_parser().footprint());
+
+        std::vector<std::string> texts = {"[\"a\\tb\",[[[[1.5]]]],{\"c\":\"d\"}]", "{\"e\":[true,false,null]}", "12345"};
+        for (const auto& text : texts)
+        {
+            json_decoder<json> decoder;
+            parser.reset();
+            parser.update(text.data(), text.size()/2);
+            parser.parse_some(decoder);
+            CHECK_FALSE(parser.done());
+            CHECK(parser.footprint() >= initial);
+            parser.update(text.data() + text.size()/2, text.size() - text.size()/2);
+            parser.finish_parse(decoder);
+            CHECK(parser.done());
+            CHECK(decoder.get_result() == json::parse(text));
+
+            // Buffers are released once the value is complete
+            CHECK(parser.footprint() == sizeof(json_parser));
+        }
+    }
+    SECTION("options")
+    {
+        auto options = json_options{}.max_nesting_depth(2).lossless_number(true);
+        json_parser parser(compact_state_arg, options);
+        json_decoder<json> decoder;
+        parser.update("[1.50]");
+        parser.finish_parse(decoder);
+        CHECK(decoder.get_result()[0].as<std::string>() == "1.50");
+
+        parser.reset();
+        parser.update("[[[1]]]");
+        std::error_code ec;
+        parser.finish_parse(decoder, ec);
+        CHECK(ec == json_errc::max_nesting_depth_exceeded);
+    }
+    SECTION("release_buffers")
+    {
+        json_parser parser;
+        json_decoder<json> decoder;
+        parser.update("[1,2]");
+        parser.finish_parse(decoder);
+        CHECK(parser.footprint() > sizeof(json_parser));
+        parser.release_buffers();
+        CHECK(parser.footprint() == sizeof(json_parser));
+        parser.reset();
+        parser.update("[3]");
+        parser.finish_parse(decoder);
+        CHECK(decoder.get_result() == json::parse("[3]"));
+    }
+}
+
+TEST_CASE("test parse_some with a budget")
+{
+    std::string input = R"({"name":"Jane Roe","scores":[1.5,-20,3e4],"flag":true,"note":"a\tbé","none":null})";
+    json expected = json::parse(input);
+
+    SECTION("budgets")
+    {
+        for (std::size_t budget = 1; budget <= 8; ++budget)
+        {
+            json_parser parser;
+            json_decoder<json> decoder;
+            parser.update(input);
+
+            std::size_t calls = 0;
+            while (!parser.finished())
+            {
+                std::size_t count = parser.parse_some(decoder, budget);
+                CHECK(count <= budget);
+                ++calls;
+            }
+            CHECK(calls >= input.size()/budget);
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("scalar at the end of the input")
+    {
+        json_parser parser;
+        json_decoder<json> decoder;
+        parser.update("12345");
+        CHECK(parser.parse_some(decoder, 3) == 3);
+        CHECK_FALSE(parser.source_exhausted());
+        CHECK_FALSE(parser.done());
+        while (!parser.finished())
+        {
+            parser.parse_some(decoder, 3);
+        }
+        CHECK(decoder.get_result() == json(12345));
+    }
+    SECTION("zero budget")
+    {
+        json_parser parser;
+        json_decoder<json> decoder;
+        parser.update("[1]");
+        CHECK(parser.parse_some(decoder, 0) == 0);
+        CHECK_FALSE(parser.stopped());
+        parser.finish_parse(decoder);
+        CHECK(decoder.get_result() == json::parse("[1]"));
+    }
+    SECTION("error")
+    {
+        json_parser parser;
+        json_decoder<json> decoder;
+        parser.update("[1,]");
+        std::error_code ec;
+        while (!parser.finished() && !ec)
+        {
+            parser.parse_some(decoder, 1, ec);
+        }
+        CHECK(ec == json_errc::extra_comma);
+    }
+}
@@ -267,3 +267,56 @@ TEST_CASE("json_reader read from string test")
 
 
 
+
+namespace {
+
+    class string_location_visitor : public default_json_visitor
+    {
+    public:
+        std::vector<const char*> locations;
+    private:
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            locations.push_back(name.data());
+            return true;
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            locations.push_back(value.data());
+            return true;
+        }
+    };
+}
+
+TEST_CASE("json_reader string_source strings in place")
+{
+    std::string s = "{\"first\" : \"" + std::string(20000, 'a') + "\", \"second\" : [\"b\", \"c\\n\"]}";
+    std::vector<char> input(s.begin(), s.end());
+
+    string_location_visitor visitor;
+    basic_json_reader<char,string_source<char>> reader(input, visitor);
+    reader.read();
+
+    REQUIRE(visitor.locations.size() == 5);
+    CHECK(visitor.locations[0] == input.data()+2);
+    CHECK(visitor.locations[1] == input.data()+12);
+    CHECK(visitor.locations[2] == input.data()+s.find("second"));
+    CHECK(visitor.locations[3] == input.data()+s.find("[\"b")+2);
+    // Escaped strings are unescaped into the parser's buffer
+    CHECK((visitor.locations[4] < input.data() || visitor.locations[4] >= input.data()+input.size()));
+}
+
+TEST_CASE("json_cursor string_source")
+{
+    std::string s = "[\"" + std::string(20000, 'a') + "\", 1]";
+    std::vector<char> input(s.begin(), s.end());
+
+    basic_json_cursor<char,string_source<char>> cursor(input);
+    REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+    cursor.next();
+    REQUIRE(cursor.current().event_type() == staj_event_type::string_value);
+    CHECK(cursor.current().get<jsoncons::string_view>().data() == input.data()+2);
+    cursor.next();
+    CHECK(cursor.current().get<int>() == 1);
+}
@@ -0,0 +1,291 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons/json_tape_parser.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct parse_result
+    {
+        std::string output;
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+    };
+
+    parse_result parse_with_json_parser(const std::string& input,
+                                        const json_options& options = json_options())
+    {
+        parse_result result;
+        json_string_encoder encoder(result.output);
+        json_parser parser(options);
+        parser.update(input.data(), input.size());
+        parser.finish_parse(encoder, result.ec);
+        if (!result.ec)
+        {
+            // As basic_json_reader does
+            parser.skip_whitespace();
+            parser.check_done(result.ec);
+        }
+        result.line = parser.line();
+        result.column = parser.column();
+        return result;
+    }
+
+    parse_result parse_with_tape_parser(const std::string& input,
+                                        const json_options& options = json_options())
+    {
+        parse_result result;
+        json_string_encoder encoder(result.output);
+        json_tape_parser parser(options);
+        parser.parse(input, encoder, result.ec);
+        result.line = parser.line();
+        result.column = parser.column();
+        return result;
+    }
+
+    // A visitor that stops at the nth event
+    class stopping_visitor : public default_json_visitor
+    {
+        int n_;
+        int count_;
+    public:
+        stopping_visitor(int n)
+            : n_(n), count_(0)
+        {
+        }
+    private:
+        bool next()
+        {
+            return ++count_ != n_;
+        }
+
+        bool visit_begin_object(semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_end_object(const ser_context&, std::error_code&) override {return next();}
+        bool visit_begin_array(semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_end_array(const ser_context&, std::error_code&) override {return next();}
+        bool visit_key(const string_view_type&, const ser_context&, std::error_code&) override {return next();}
+        bool visit_null(semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_string(const string_view_type&, semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_bool(bool, semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_int64(int64_t, semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_uint64(uint64_t, semantic_tag, const ser_context&, std::error_code&) override {return next();}
+        bool visit_double(double, semantic_tag, const ser_context&, std::error_code&) override {return next();}
+    };
+
+    void check_same_as_json_parser(const std::string& input,
+                                   const json_options& options = json_options())
+    {
+        parse_result expected = parse_with_json_parser(input, options);
+        parse_result result = parse_with_tape_parser(input, options);
+
+        INFO(input);
+        CHECK(result.ec == expected.ec);
+        if (expected.ec)
+        {
+            CHECK(result.line == expected.line);
+            CHECK(result.column == expected.column);
+        }
+        else
+        {
+            CHECK(result.output == expected.output);
+        }
+    }
+}
+
+TEST_CASE("json_tape_parser valid input")
+{
+    std::vector<std::string> inputs = {
+        "{}", "[]", " { } ", "[[[]]]", "0", "-0", "123", " -123 ", "1.5", "-1.5e10", "1E-5", "0.0e+1",
+        "true", "false", "null", "\"\"", "\"abc\"", "[true,false,null]",
+        "{\"a\":1,\"b\":[1,2,{\"c\":null}],\"d\":{\"e\":\"f\"}}",
+        "[18446744073709551615,18446744073709551616,-9223372036854775808,-9223372036854775809]",
+        "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\", \"\\u00e9\\u20AC\\ud83d\\ude00\"]",
+        "\"\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\"",
+        "{\r\n  \"a\" :\t[ 1 ,\n 2 ]\r\n}\r\n",
+        "[\"a\\\\\",\"b\\\\\\\"\",\"\\\\\\\\\"]"
+    };
+    for (const auto& input : inputs)
+    {
+        check_same_as_json_parser(input);
+    }
+}
+
+TEST_CASE("json_tape_parser invalid input")
+{
+    std::vector<std::string> inputs = {
+        "", " ", "{", "[", "]", "}", "[1,]", "{\"a\":1,}", "[1 2]", "{\"a\" 1}", "{1:2}", "{\"a\":}",
+        "01", "-", "1.", ".5", "1e", "1e+", "+1", "tru", "truex", "nul", "[1]x", "[1] [2]", "\"abc",
+        "\"a\tb\"", "\"a\\x\"", "\"\\u12\"", "\"\\ud800\"", "\"\\ud800x\"", "\"\xff\"", "[\"a\" \"b\"]",
+        "{\"a\":1 \"b\":2}", "[1,,2]", "\x01", "[\n1,\n2\n,]", "[1}", "{\"a\":1]", "\"\\\"",
+        "{\"a\":{\"b\":[1,2,[3,{]}]}}"
+    };
+    for (const auto& input : inputs)
+    {
+        check_same_as_json_parser(input);
+    }
+}
+
+TEST_CASE("json_tape_parser block boundaries")
+{
+    // Escapes, quotation marks and tokens at every offset around the 64 character blocks
+    for (std::size_t n = 0; n < 140; ++n)
+    {
+        std::string padding(n, ' ');
+        check_same_as_json_parser("[" + padding + "\"a\\\\\", \"b\\\"c\", 123, true]");
+        check_same_as_json_parser("[\"" + std::string(n, 'x') + "\\\\\", \"" + std::string(n, 'y') + "\\\"\", 1]");
+        check_same_as_json_parser("[\"" + std::string(n, 'x') + "\\\\\\\\\",-45.5e1," + padding + "null]");
+        check_same_as_json_parser("{\"" + std::string(n, 'k') + "\":" + padding + "1234567890}");
+        check_same_as_json_parser("[\"" + std::string(n, 'x') + "\\\\\"]" + padding + "x");
+    }
+}
+
+TEST_CASE("json_tape_parser options")
+{
+    SECTION("lossless number")
+    {
+        json_options options;
+        options.lossless_number(true);
+        check_same_as_json_parser("[1.5,-0.25e3,100]", options);
+    }
+    SECTION("nan, inf and neginf replacements")
+    {
+        json_options options;
+        options.nan_to_str("NaN")
+               .inf_to_str("Inf")
+               .neginf_to_str("-Inf");
+        check_same_as_json_parser("[\"NaN\",\"Inf\",\"-Inf\",\"x\"]", options);
+    }
+    SECTION("max nesting depth")
+    {
+        json_options options;
+        options.max_nesting_depth(3);
+        check_same_as_json_parser("[[[1]]]", options);
+        check_same_as_json_parser("[[[[1]]]]", options);
+        check_same_as_json_parser("{\"a\":{\"b\":{\"c\":{}}}}", options);
+    }
+}
+
+TEST_CASE("json_tape_parser comments")
+{
+    check_same_as_json_parser("[1, /* two */ 2, // three\n 3]");
+    check_same_as_json_parser("/* \"unterminated */ {\"a\":\"b\"}");
+    check_same_as_json_parser("[\"not/a/comment\"]");
+}
+
+TEST_CASE("json_tape_parser documents")
+{
+    std::vector<std::string> paths = {"./input/address-book.json", "./input/countries.json", "./input/cyrillic.json", "./input/members.json"};
+    for (const auto& path : paths)
+    {
+        std::ifstream is(path);
+        REQUIRE(is);
+        std::stringstream ss;
+        ss << is.rdbuf();
+        check_same_as_json_parser(ss.str());
+    }
+}
+
+TEST_CASE("json_tape_parser with json_decoder")
+{
+    std::string input = R"({"store":{"book":[{"title":"Sayings of the Century","price":8.95},{"title":"Moby Dick","price":8.99}]}})";
+
+    json_decoder<json> decoder;
+    json_tape_parser parser;
+    parser.parse(input, decoder);
+    json j = decoder.get_result();
+
+    CHECK(j == json::parse(input));
+    CHECK(j["store"]["book"][1]["price"].as<double>() == 8.99);
+}
+
+TEST_CASE("json_tape_parser with json_decoder and content after the root value")
+{
+    std::vector<std::string> inputs = {
+        "[1]]", "[1] 2", "{\"a\":1}}", "\"k\":\"x\"", "2464{362696", "2464{", "1 2", "1]", "[1]\n  x",
+        "true false", "\"a\"\"b\"", "nullx", "{}[", "[1] /", "[1,2", "{\"a\":", "[1]  ", "\"x\"\n"
+    };
+    for (const auto& input : inputs)
+    {
+        INFO(input);
+        std::error_code expected_ec;
+        json_decoder<json> expected_decoder;
+        json_reader reader(input, expected_decoder);
+        reader.read(expected_ec);
+
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_tape_parser parser;
+        parser.parse(input, decoder, ec);
+
+        CHECK(ec == expected_ec);
+        if (expected_ec)
+        {
+            CHECK(parser.line() == reader.line());
+            CHECK(parser.column() == reader.column());
+        }
+        else
+        {
+            CHECK(decoder.get_result() == expected_decoder.get_result());
+        }
+    }
+}
+
+TEST_CASE("json_tape_parser with a visitor that stops")
+{
+    std::vector<std::string> inputs = {
+        "[1,\"a\\\"b\" , {\"k\" : true}]", "{\"k\" : [ 1 ]}", "[1,2]", "[-1.5,2]", "[1 ,2]",
+        "{\"a\":1,\"b\":2}", "[[],{},2]", "[null, false]"
+    };
+    for (const auto& input : inputs)
+    {
+        for (int n = 1; n <= 8; ++n)
+        {
+            INFO(input << " stopping at event " << n);
+            std::error_code expected_ec;
+            stopping_visitor expected_visitor(n);
+            json_reader reader(input, expected_visitor);
+            reader.read(expected_ec);
+
+            std::error_code ec;
+            stopping_visitor visitor(n);
+            json_tape_parser parser;
+            parser.parse(input, visitor, ec);
+
+            CHECK(ec == expected_ec);
+            if (expected_ec)
+            {
+                CHECK(parser.line() == reader.line());
+                CHECK(parser.column() == reader.column());
+            }
+        }
+    }
+}
+
+TEST_CASE("json_tape_parser throws ser_error")
+{
+    json_decoder<json> decoder;
+    json_tape_parser parser;
+    REQUIRE_THROWS_AS(parser.parse(std::string("[1,2"), decoder), ser_error);
+}
+
+TEST_CASE("wjson_tape_parser")
+{
+    std::wstring input = L"{\"a\":[1,2.5,\"\\u00e9\",true]}";
+
+    json_decoder<wjson> decoder;
+    wjson_tape_parser parser;
+    parser.parse(input, decoder);
+    wjson j = decoder.get_result();
+
+    CHECK(j == wjson::parse(input));
+}
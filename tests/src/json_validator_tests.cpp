@@ -0,0 +1,229 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_validator.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct parse_result
+    {
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+    };
+
+    parse_result read_json(const std::string& input,
+                           std::function<bool(json_errc,const ser_context&)> err_handler,
+                           std::size_t buffer_length)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder, err_handler);
+        reader.buffer_length(buffer_length);
+        std::error_code ec;
+        reader.read(ec);
+        return parse_result{ec, reader.line(), reader.column()};
+    }
+
+    parse_result validate_json(const std::string& input,
+                               std::function<bool(json_errc,const ser_context&)> err_handler,
+                               std::size_t buffer_length)
+    {
+        std::istringstream is(input);
+        json_validator validator(is, err_handler);
+        validator.buffer_length(buffer_length);
+        std::error_code ec;
+        validator.validate(ec);
+        return parse_result{ec, validator.line(), validator.column()};
+    }
+
+    const std::vector<std::string> inputs = {
+        R"({"a":[1,-2,3.5e10,-0.0,1E-7,true,false,null],"b":{"c":"d"}})",
+        R"("A \"quoted\" string with \\ and \/ and \b\f\n\r\t")",
+        R"(["Aé中😀"])",
+        "[\"\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\"]",
+        R"([18446744073709551615,18446744073709551616,-9223372036854775808,-9223372036854775809])",
+        R"([123456789012345678901234567890.5e-400])",
+        "\n\t [ 1 ,\r\n 2 ] \n ",
+        R"(/* comment */ [1,2])",
+        R"({"a":1,})",
+        R"([1,2,])",
+        R"([1 2])",
+        R"({"a" 1})",
+        R"({1:2})",
+        R"([01])",
+        R"([1.])",
+        R"([.5])",
+        R"([1e])",
+        R"([-])",
+        R"([+1])",
+        R"([0x10])",
+        R"(["\x"])",
+        R"(["\u12"])",
+        R"(["\ud800"])",
+        R"(["\ud800A"])",
+        R"(["\udc00"])",
+        "[\"tab\tin string\"]",
+        "[\"new\nline\"]",
+        "[\"\x01\"]",
+        "[\"\xc3\"]",
+        "[\"\xc3\x28\"]",
+        "[\"\xed\xa0\x80\"]",
+        "[\"\xf8\x88\x80\x80\x80\"]",
+        "[\"abc\xff\"]",
+        R"([tru])",
+        R"([nul])",
+        R"([fals])",
+        R"([True])",
+        R"([1]x)",
+        R"([1] [2])",
+        R"({"a":1}})",
+        R"([1]])",
+        R"([1] 2)",
+        R"("k":"x")",
+        R"(2464{362696)",
+        R"(1 2)",
+        R"(1])",
+        R"(-1.5])",
+        R"(0})",
+        R"(true])",
+        "[1]\n  x",
+        R"(]1)",
+        R"([1}])",
+        R"({"a":[1}})",
+        R"([[[[[]]]]])",
+        R"(["unterminated)",
+        R"({"a":)",
+        R"([)",
+        "",
+        "   ",
+        R"(1)",
+        R"(-1.5)",
+        R"("")",
+        R"(null)",
+    };
+
+    void check_same(const std::string& input,
+                    std::function<bool(json_errc,const ser_context&)> err_handler,
+                    std::size_t buffer_length)
+    {
+        parse_result expected = read_json(input, err_handler, buffer_length);
+        parse_result result = validate_json(input, err_handler, buffer_length);
+        INFO(input);
+        INFO("buffer length " << buffer_length);
+        CHECK(result.ec == expected.ec);
+        CHECK(result.line == expected.line);
+        CHECK(result.column == expected.column);
+    }
+
+} // namespace
+
+TEST_CASE("json_validator agrees with json_reader")
+{
+    const std::vector<std::size_t> buffer_lengths = {1, 3, 7, 16384};
+
+    SECTION("default_json_parsing")
+    {
+        for (const auto& input : inputs)
+        {
+            for (auto length : buffer_lengths)
+            {
+                check_same(input, default_json_parsing(), length);
+            }
+        }
+    }
+    SECTION("strict_json_parsing")
+    {
+        for (const auto& input : inputs)
+        {
+            for (auto length : buffer_lengths)
+            {
+                check_same(input, strict_json_parsing(), length);
+            }
+        }
+    }
+    SECTION("recovering error handler")
+    {
+        auto err_handler = [](json_errc ec, const ser_context&) -> bool
+        {
+            return ec == json_errc::extra_comma || ec == json_errc::illegal_comment ||
+                   ec == json_errc::illegal_character_in_string || ec == json_errc::extra_character;
+        };
+        for (const auto& input : inputs)
+        {
+            for (auto length : buffer_lengths)
+            {
+                check_same(input, err_handler, length);
+            }
+        }
+    }
+}
+
+TEST_CASE("json_validator")
+{
+    SECTION("string input")
+    {
+        std::string input = R"({"a":[1,2,3]})";
+        json_validator validator(input);
+        CHECK(validator.is_valid());
+    }
+    SECTION("first error position")
+    {
+        std::string input = "{\"a\":1,\n \"b\":[1,2,]}";
+        json_validator validator(input);
+        std::error_code ec;
+        validator.validate(ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(validator.line() == 2);
+        CHECK(validator.column() == 11);
+    }
+    SECTION("max_nesting_depth")
+    {
+        json_options options;
+        options.max_nesting_depth(3);
+        std::string input1 = "[[[1]]]";
+        CHECK(json_validator(input1, options).is_valid());
+        std::string input2 = "[[[[1]]]]";
+        json_validator validator(input2, options);
+        std::error_code ec;
+        validator.validate(ec);
+        CHECK(ec == json_errc::max_nesting_depth_exceeded);
+    }
+    SECTION("throws ser_error")
+    {
+        std::string input = "[1,2";
+        json_validator validator(input);
+        CHECK_THROWS_AS(validator.validate(), ser_error);
+    }
+}
+
+TEST_CASE("basic_json_parser validate only mode")
+{
+    // The visitor is not called
+    class throwing_visitor : public default_json_visitor
+    {
+        bool visit_uint64(uint64_t, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            JSONCONS_THROW(std::runtime_error("Unexpected call"));
+        }
+        bool visit_string(const string_view_type&, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            JSONCONS_THROW(std::runtime_error("Unexpected call"));
+        }
+    };
+
+    json_parser parser(validate_only_arg);
+    throwing_visitor visitor;
+    std::error_code ec;
+    parser.update(R"({"a":[1,2,"b"]})");
+    parser.finish_parse(visitor, ec);
+    CHECK_FALSE(ec);
+    CHECK(parser.done());
+}
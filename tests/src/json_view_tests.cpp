@@ -0,0 +1,286 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_view.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Rebuilds a json value by walking the view, the first of duplicate keys wins as with parse
+    json to_json(const json_view& v)
+    {
+        if (v.is_object())
+        {
+            json j(json_object_arg);
+            for (const auto& member : v.object_range())
+            {
+                j.try_emplace(member.key(), to_json(member.value()));
+            }
+            return j;
+        }
+        if (v.is_array())
+        {
+            json j(json_array_arg);
+            for (const auto& element : v.array_range())
+            {
+                j.push_back(to_json(element));
+            }
+            return j;
+        }
+        return v.as<json>();
+    }
+}
+
+TEST_CASE("json_view navigation")
+{
+    std::string input = R"(
+{
+    "store": {
+        "book": [
+            {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+            {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99}
+        ],
+        "bicycle": {"color": "red", "price": 19.95, "new": true, "sold": null}
+    }
+}
+    )";
+    json expected = json::parse(input);
+
+    json_index index(input);
+    json_view root = index.root();
+
+    CHECK(root.is_object());
+    CHECK(root.size() == 1);
+    CHECK(root.contains("store"));
+    CHECK_FALSE(root.contains("book"));
+
+    json_view books = root["store"]["book"];
+    CHECK(books.is_array());
+    CHECK(books.size() == 2);
+    CHECK(books[1].at("title").as<std::string>() == "Moby Dick");
+    CHECK(books[0]["price"].as<double>() == 8.95);
+    CHECK(books[1].at("isbn").raw() == "\"0-553-21311-3\"");
+
+    json_view bicycle = root.at("store").at("bicycle");
+    CHECK(bicycle["new"].is_bool());
+    CHECK(bicycle["new"].as<bool>());
+    CHECK(bicycle["sold"].is_null());
+    CHECK(bicycle["price"].is_number());
+    CHECK(bicycle["color"].is_string());
+
+    CHECK(root.as<json>() == expected);
+    CHECK(books.as<json>() == expected["store"]["book"]);
+    CHECK(to_json(root) == expected);
+
+    std::vector<std::string> titles;
+    for (const auto& book : books.array_range())
+    {
+        titles.push_back(book["title"].as<std::string>());
+    }
+    CHECK(titles == std::vector<std::string>{"Sayings of the Century", "Moby Dick"});
+
+    // A view always refers to a value in an index
+    CHECK_FALSE(std::is_default_constructible<json_view>::value);
+}
+
+TEST_CASE("json_view same as parse")
+{
+    std::vector<std::string> inputs = {
+        "{}", "[]", "0", " -1.5e3 ", "\"abc\"", "true", "null", "[[],{},[[1]]]",
+        "[18446744073709551615,18446744073709551616,-9223372036854775808]",
+        "{\"a\\\"b\":\"\\u00e9\",\"\xe6\x97\xa5\":[1,\"x\"]}",
+        "{\"a\":1,\"a\":2}"
+    };
+    for (const auto& input : inputs)
+    {
+        INFO(input);
+        json_index index(input);
+        CHECK(index.root().as<json>() == json::parse(input));
+        CHECK(to_json(index.root()) == json::parse(input));
+    }
+
+    std::vector<std::string> paths = {"./input/address-book.json", "./input/countries.json", "./input/cyrillic.json", "./input/employees.json"};
+    for (const auto& path : paths)
+    {
+        std::ifstream is(path);
+        REQUIRE(is);
+        std::stringstream ss;
+        ss << is.rdbuf();
+        std::string input = ss.str();
+
+        json_index index(input);
+        CHECK(to_json(index.root()) == json::parse(input));
+    }
+}
+
+TEST_CASE("json_view from several threads")
+{
+    std::string input = "[";
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i > 0)
+        {
+            input.push_back(',');
+        }
+        input.append("{\"id\":" + std::to_string(i) + ",\"name\":\"name " + std::to_string(i) + "\",\"values\":[1.5,2.5,3.5]}");
+    }
+    input.push_back(']');
+    json expected = json::parse(input);
+
+    json_index index(input);
+    json_view root = index.root();
+    CHECK(root.size() == 100);
+
+    std::vector<int> matches(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < matches.size(); ++t)
+    {
+        threads.emplace_back([&root,&expected,&matches,t]()
+        {
+            for (std::size_t i = 0; i < 100; ++i)
+            {
+                if (root[i].as<json>() == expected[i])
+                {
+                    ++matches[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    CHECK(matches == std::vector<int>(4, 100));
+}
+
+TEST_CASE("json_view keys")
+{
+    std::string input = "{\"a\\\"b\":1,\"\\u00e9\":2,\"\xc3\xa9t\xc3\xa9\":3,\"NaN\":4}";
+    json_options options;
+    options.nan_to_str("NaN");
+
+    json_index index(input, options);
+    json_view root = index.root();
+    CHECK(root["a\"b"].as<int>() == 1);
+    CHECK(root["\xc3\xa9"].as<int>() == 2);
+    CHECK(root["\xc3\xa9t\xc3\xa9"].as<int>() == 3);
+    CHECK(root["NaN"].as<int>() == 4);
+
+    std::vector<std::string> keys;
+    for (const auto& member : root.object_range())
+    {
+        keys.push_back(member.key());
+    }
+    CHECK(keys == std::vector<std::string>{"a\"b", "\xc3\xa9", "\xc3\xa9t\xc3\xa9", "NaN"});
+}
+
+TEST_CASE("json_view options")
+{
+    std::string input = "[\"NaN\",1.5]";
+    json_options options;
+    options.nan_to_str("NaN")
+           .lossless_number(true);
+
+    json_index index(input, options);
+    json expected = json::parse(input, options);
+    CHECK(std::isnan(index.root()[0].as<json>().as<double>()));
+    CHECK(std::isnan(expected[0].as<double>()));
+    CHECK(index.root()[1].as<json>() == expected[1]);
+    CHECK(std::isnan(index.root()[0].as<double>()));
+    CHECK(index.root()[1].as<json>().tag() == semantic_tag::bigdec);
+}
+
+TEST_CASE("json_view errors")
+{
+    SECTION("unmatched brackets")
+    {
+        CHECK_THROWS_AS(json_index(std::string("{\"a\":[1,2}")), ser_error);
+        CHECK_THROWS_AS(json_index(std::string("[1,2")), ser_error);
+        CHECK_THROWS_AS(json_index(std::string("[1] [2]")), ser_error);
+        CHECK_THROWS_AS(json_index(std::string("")), ser_error);
+    }
+    SECTION("content after the root value")
+    {
+        std::vector<std::string> inputs = {"[1]]", "[1] 2", "{\"a\":1}}", "\"k\":\"x\"", "2464{362696", "1 2", "[1]\n  x"};
+        for (const auto& input : inputs)
+        {
+            INFO(input);
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_reader reader(input, decoder);
+            reader.read(ec);
+            REQUIRE(ec);
+            try
+            {
+                json_index index(input);
+                index.root().as<json>();
+                CHECK(false);
+            }
+            catch (const ser_error& e)
+            {
+                CHECK(e.code() == ec);
+                CHECK(e.line() == reader.line());
+                CHECK(e.column() == reader.column());
+            }
+        }
+    }
+    SECTION("comments")
+    {
+        CHECK_THROWS_AS(json_index(std::string("[1, /* two */ 2]")), ser_error);
+    }
+    SECTION("lookup")
+    {
+        std::string input = "{\"a\":[1,2],\"b\":\"c\"}";
+        json_index index(input);
+        json_view root = index.root();
+
+        CHECK_THROWS_AS(root.at("x"), key_not_found);
+        CHECK_THROWS_AS(root["a"]["x"], not_an_object);
+        CHECK_THROWS_AS(root["a"][2], std::out_of_range);
+        CHECK_THROWS_AS(root["b"][0], std::domain_error);
+        CHECK(root["a"][1].as<int>() == 2);
+    }
+    SECTION("errors in values are reported when accessed")
+    {
+        std::string input = "{\n  \"a\": [1,2],\n  \"b\": [1, tru]\n}";
+        json_index index(input);
+        json_view root = index.root();
+
+        CHECK(root["a"].as<json>() == json::parse("[1,2]"));
+        try
+        {
+            root["b"].as<json>();
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_reader reader(input, decoder);
+            reader.read(ec);
+            CHECK(e.code() == ec);
+            CHECK(e.line() == reader.line());
+            CHECK(e.column() == reader.column());
+        }
+    }
+}
+
+TEST_CASE("wjson_view")
+{
+    std::wstring input = L"{\"a\":[1,2.5,\"\\u00e9\",true]}";
+    wjson_index index(input);
+    wjson_view root = index.root();
+
+    CHECK(root[L"a"].size() == 4);
+    CHECK(root[L"a"][2].as<std::wstring>() == L"\u00e9");
+    CHECK(root.as<wjson>() == wjson::parse(input));
+}
@@ -0,0 +1,119 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <cstdio> // std::remove
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+#if defined(JSONCONS_HAS_MMAP)
+
+TEST_CASE("mmap_source tests")
+{
+    std::string path = "./input/address-book.json";
+    std::ifstream is(path);
+    REQUIRE(is);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    json expected = json::parse(ss.str());
+
+    SECTION("json_reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+    SECTION("json_cursor")
+    {
+        basic_json_cursor<char,mmap_source<char>> cursor{mmap_source<char>(path)};
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            ++count;
+        }
+        CHECK(count > 0);
+    }
+    SECTION("read in place")
+    {
+        mmap_source<char> source(path);
+        CHECK_FALSE(source.is_error());
+        CHECK(source.peek_character().value() == ss.str()[0]);
+        auto s = source.read_buffer();
+        CHECK(std::string(s.data(), s.size()) == ss.str());
+        CHECK(source.eof());
+    }
+    SECTION("missing file")
+    {
+        std::error_code ec;
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>("./input/does-not-exist.json"), decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+    SECTION("empty file")
+    {
+        std::string empty_path = "./output/empty.json";
+        {
+            std::ofstream os(empty_path);
+        }
+        {
+            mmap_source<char> source(empty_path);
+            CHECK_FALSE(source.is_error());
+            CHECK(source.eof());
+
+            std::error_code ec;
+            json_decoder<json> decoder;
+            basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>(empty_path), decoder);
+            reader.read(ec);
+            CHECK(ec == json_errc::unexpected_eof);
+        }
+        std::remove(empty_path.c_str());
+    }
+}
+
+TEST_CASE("binary_mmap_source tests")
+{
+    json expected = json::parse(R"({"a":[1,2.5,"three",null,true],"b":{"c":-4}})");
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(expected, data);
+
+    std::string path = "./output/mmap_source.cbor";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    SECTION("cbor_reader")
+    {
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_mmap_source> reader(binary_mmap_source(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+    SECTION("read")
+    {
+        binary_mmap_source source(path);
+        CHECK_FALSE(source.is_error());
+        std::vector<uint8_t> v;
+        CHECK(source_reader<binary_mmap_source>::read(source, v, data.size()) == data.size());
+        CHECK(v == data);
+        CHECK(source.eof());
+    }
+    SECTION("missing file")
+    {
+        binary_mmap_source source("./output/does-not-exist.cbor");
+        CHECK(source.is_error());
+    }
+
+    std::remove(path.c_str());
+}
+
+#endif
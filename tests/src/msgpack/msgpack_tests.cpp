@@ -415,3 +415,46 @@ TEST_CASE("msgpack timestamp tests")
     }
 }
 
+
+TEST_CASE("msgpack_parser parse with a budget")
+{
+    json expected = json::parse(R"(
+        {"a":[1,-2,"three",[],{"b":null}],"c":true,"d":1.5}
+    )");
+    std::vector<uint8_t> input;
+    encode_msgpack(expected, input);
+
+    for (std::size_t budget = 1; budget <= 3; ++budget)
+    {
+        json_decoder<json> destination;
+        json_visitor2_to_visitor_adaptor visitor{destination};
+
+        basic_msgpack_parser<bytes_source> parser{ bytes_source(input) };
+
+        std::error_code ec;
+        std::size_t calls = 0;
+        while (!parser.done() && !parser.stopped())
+        {
+            std::size_t count = parser.parse(visitor, budget, ec);
+            REQUIRE_FALSE(ec);
+            CHECK(count <= budget);
+            ++calls;
+        }
+        CHECK(calls >= 16/budget);
+        CHECK(destination.get_result() == expected);
+    }
+
+    SECTION("truncated")
+    {
+        input.pop_back();
+        json_decoder<json> destination;
+        json_visitor2_to_visitor_adaptor visitor{destination};
+        basic_msgpack_parser<bytes_source> parser{ bytes_source(input) };
+        std::error_code ec;
+        while (!parser.done() && !parser.stopped())
+        {
+            parser.parse(visitor, 2, ec);
+        }
+        CHECK(ec == msgpack_errc::unexpected_eof);
+    }
+}
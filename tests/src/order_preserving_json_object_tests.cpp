@@ -410,3 +410,38 @@ TEST_CASE("order preserving erase")
     }
 }
   
+
+TEST_CASE("order preserving large object")
+{
+    ojson o(json_object_arg);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string key = "key" + std::to_string((i*7) % 1000);
+        std::size_t pos = o.size() / 2;
+        o.try_emplace(o.object_range().begin() + pos, key, i);
+        keys.insert(keys.begin() + pos, key);
+    }
+    o.insert_or_assign(keys[500], -1);
+    CHECK(o.size() == keys.size());
+
+    // Erase ranges from the middle
+    while (keys.size() > 5)
+    {
+        std::size_t pos = keys.size() / 3;
+        std::size_t n = keys.size() > 10 ? 10 : 1;
+        o.erase(o.object_range().begin() + pos, o.object_range().begin() + pos + n);
+        keys.erase(keys.begin() + pos, keys.begin() + pos + n);
+        REQUIRE(o.size() == keys.size());
+        std::size_t i = 0;
+        for (const auto& member : o.object_range())
+        {
+            REQUIRE(member.key() == keys[i++]);
+        }
+        for (const auto& key : keys)
+        {
+            REQUIRE(o.contains(key));
+        }
+    }
+    CHECK_FALSE(o.contains("key-1"));
+}
@@ -0,0 +1,227 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+#include <jsoncons_ext/jsonpatch/jsonpatch.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+#if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
+
+#include <memory_resource>
+
+using namespace jsoncons;
+
+namespace {
+
+    // A memory resource that counts the bytes it hands out, and frees them on destruction
+    class counting_resource : public std::pmr::memory_resource
+    {
+        std::pmr::memory_resource* upstream_;
+        std::size_t allocated_;
+    public:
+        counting_resource()
+            : upstream_(std::pmr::new_delete_resource()), allocated_(0)
+        {
+        }
+
+        std::size_t allocated() const
+        {
+            return allocated_;
+        }
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            allocated_ += bytes;
+            return upstream_->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            allocated_ -= bytes;
+            upstream_->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    const std::string long_string = "A string too long for the short string optimization";
+
+    const std::string input = R"(
+    {
+        "store": {
+            "book": [
+                {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+                {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99},
+                {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99}
+            ]
+        }
+    }
+    )";
+
+    template <class Json>
+    Json parse(const std::string& s, const typename Json::allocator_type& alloc)
+    {
+        json_decoder<Json> decoder(result_allocator_arg, alloc);
+        json_reader reader(s, decoder);
+        reader.read();
+        return decoder.get_result();
+    }
+
+} // namespace
+
+TEST_CASE("pmr::json parse")
+{
+    counting_resource resource;
+    std::pmr::polymorphic_allocator<char> alloc(&resource);
+
+    SECTION("pmr::json")
+    {
+        {
+            pmr::json j = parse<pmr::json>(input, alloc);
+            CHECK(j.get_allocator().resource() == &resource);
+            CHECK(j["store"]["book"].size() == 3);
+            CHECK(j["store"]["book"][2]["isbn"].as<std::string>() == "0-553-21311-3");
+            CHECK(resource.allocated() > 0);
+        }
+        CHECK(resource.allocated() == 0);
+    }
+    SECTION("pmr::ojson")
+    {
+        {
+            pmr::ojson j = parse<pmr::ojson>(input, alloc);
+            CHECK(j["store"]["book"][0].object_range().begin()->key() == "category");
+            CHECK(resource.allocated() > 0);
+        }
+        CHECK(resource.allocated() == 0);
+    }
+    SECTION("monotonic_buffer_resource")
+    {
+        std::pmr::monotonic_buffer_resource pool;
+        pmr::json j = parse<pmr::json>(input, std::pmr::polymorphic_allocator<char>(&pool));
+        CHECK(j["store"]["book"][1]["author"].as<std::string>() == "Evelyn Waugh");
+    }
+    SECTION("unsynchronized_pool_resource")
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+        pmr::json j = parse<pmr::json>(input, std::pmr::polymorphic_allocator<char>(&pool));
+        CHECK(j["store"]["book"][1]["author"].as<std::string>() == "Evelyn Waugh");
+    }
+}
+
+TEST_CASE("pmr::json construct, copy and merge")
+{
+    counting_resource resource;
+    std::pmr::polymorphic_allocator<char> alloc(&resource);
+    {
+        pmr::json j(json_object_arg, semantic_tag::none, alloc);
+        j.try_emplace("a", long_string, alloc);
+        j.try_emplace("b", json_array_arg, semantic_tag::none, alloc);
+        j["b"].emplace_back(long_string, alloc);
+        j["b"].emplace_back(1);
+        CHECK(resource.allocated() > 0);
+
+        pmr::json copy(j, alloc);
+        CHECK(copy == j);
+        CHECK(copy.get_allocator().resource() == &resource);
+
+        pmr::json other(json_object_arg, semantic_tag::none, alloc);
+        other.try_emplace("c", long_string, alloc);
+        other.try_emplace("a", 1);
+        copy.merge(other);
+        CHECK(copy.size() == 3);
+        CHECK(copy["a"].as<std::string>() == long_string);
+        copy.merge_or_update(other);
+        CHECK(copy["a"].as<int>() == 1);
+
+        pmr::json moved = std::move(copy);
+        CHECK(moved["c"].as<std::string>() == long_string);
+
+        pmr::json assigned(json_object_arg, semantic_tag::none, alloc);
+        assigned = j;
+        CHECK(assigned == j);
+        assigned = moved;
+        CHECK(assigned == moved);
+    }
+    CHECK(resource.allocated() == 0);
+}
+
+TEST_CASE("pmr::json emplace without an allocator argument")
+{
+    // Anything that falls back to the default resource throws std::bad_alloc
+    std::pmr::memory_resource* default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    counting_resource resource;
+    std::pmr::polymorphic_allocator<char> alloc(&resource);
+    {
+        pmr::json a(json_array_arg, semantic_tag::none, alloc);
+        CHECK_NOTHROW(a.emplace_back(long_string));
+        CHECK_NOTHROW(a.emplace_back(long_string.c_str()));
+        CHECK_NOTHROW(a.emplace_back(json_object_arg));
+        CHECK_NOTHROW(a.emplace_back(1));
+        REQUIRE(a.size() == 4);
+        CHECK(a[0].as<std::string>() == long_string);
+        CHECK(a[1].as<std::string>() == long_string);
+
+        pmr::json j(json_object_arg, semantic_tag::none, alloc);
+        CHECK_NOTHROW(j.try_emplace(long_string, long_string));
+        CHECK_NOTHROW(j.try_emplace("b", long_string.c_str()));
+        CHECK_NOTHROW(j.try_emplace("c", json_array_arg));
+        CHECK_NOTHROW(j["c"].emplace_back(long_string));
+        CHECK(j[long_string].as<std::string>() == long_string);
+        CHECK(j["c"][0].as<std::string>() == long_string);
+
+        pmr::ojson o(json_object_arg, semantic_tag::none, alloc);
+        CHECK_NOTHROW(o.try_emplace(long_string, long_string));
+        CHECK(o[long_string].as<std::string>() == long_string);
+        CHECK(resource.allocated() > 0);
+    }
+    CHECK(resource.allocated() == 0);
+
+    std::pmr::set_default_resource(default_resource);
+}
+
+TEST_CASE("pmr::json jsonpath")
+{
+    counting_resource resource;
+    std::pmr::polymorphic_allocator<char> alloc(&resource);
+    {
+        pmr::json j = parse<pmr::json>(input, alloc);
+
+        pmr::json result = jsonpath::json_query(j, "$.store.book[?(@.price < 10)].title");
+        REQUIRE(result.size() == 2);
+        CHECK(result[0].as<std::string>() == "Sayings of the Century");
+        CHECK(result[1].as<std::string>() == "Moby Dick");
+
+        pmr::json paths = jsonpath::json_query(j, "$..isbn", jsonpath::result_type::path);
+        REQUIRE(paths.size() == 1);
+        CHECK(paths[0].as<std::string>() == "$['store']['book'][2]['isbn']");
+
+        jsonpath::json_replace(j, "$.store.book[*].price", 10.0);
+        CHECK(j["store"]["book"][1]["price"].as<double>() == 10.0);
+    }
+    CHECK(resource.allocated() == 0);
+}
+
+TEST_CASE("pmr::json jsonpatch")
+{
+    counting_resource resource;
+    std::pmr::polymorphic_allocator<char> alloc(&resource);
+    {
+        pmr::json source = parse<pmr::json>(R"({"a":"A string too long for the short string optimization","b":[1,2,3]})", alloc);
+        pmr::json target = parse<pmr::json>(R"({"a":"Another string too long for the short string optimization","b":[1,3],"c":{"d":true}})", alloc);
+
+        pmr::json patch = jsonpatch::from_diff(source, target);
+        CHECK(patch.size() > 0);
+
+        std::error_code ec;
+        jsonpatch::apply_patch(source, patch, ec);
+        CHECK_FALSE(ec);
+        CHECK(source == target);
+    }
+    CHECK(resource.allocated() == 0);
+}
+
+#endif // defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
@@ -0,0 +1,170 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/prefetch_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_text(std::size_t count)
+    {
+        std::string s = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s += "{\"id\":" + std::to_string(i) + ",\"name\":\"record-" + std::to_string(i) + "\"}";
+        }
+        s.push_back(']');
+        return s;
+    }
+
+    // Fails after size characters have been read
+    class failing_buffer : public std::streambuf
+    {
+        std::string data_;
+    public:
+        failing_buffer(const std::string& data, std::size_t size)
+            : data_(data.substr(0, size))
+        {
+            setg(&data_[0], &data_[0], &data_[0] + data_.size());
+        }
+    protected:
+        int_type underflow() override
+        {
+            throw std::runtime_error("read failed");
+        }
+    };
+}
+
+TEST_CASE("prefetch_source tests")
+{
+    std::string input = make_text(1000);
+
+    SECTION("get, peek, ignore and read across blocks")
+    {
+        std::istringstream is(input);
+        prefetch_source<stream_source<char>> source(is, 7);
+
+        CHECK(source.peek_character().value() == input[0]);
+        CHECK(source.get_character().value() == input[0]);
+        source.ignore(10);
+        CHECK(source.position() == 11);
+        std::vector<char> buf(100);
+        CHECK(source.read(buf.data(), buf.size()) == 100);
+        CHECK(std::string(buf.data(), buf.size()) == input.substr(11, 100));
+
+        std::string rest;
+        while (!source.eof())
+        {
+            auto s = source.read_buffer();
+            rest.append(s.data(), s.size());
+        }
+        CHECK(rest == input.substr(111));
+        CHECK_FALSE(source.get_character());
+        CHECK_FALSE(source.is_error());
+    }
+    SECTION("move")
+    {
+        std::istringstream is(input);
+        prefetch_source<stream_source<char>> source(is, 16);
+        source.ignore(3);
+        prefetch_source<stream_source<char>> source2(std::move(source));
+        CHECK(source2.get_character().value() == input[3]);
+        CHECK_FALSE(source.get_character());
+    }
+    SECTION("stream error")
+    {
+        failing_buffer buf(input, 100);
+        std::istream is(&buf);
+        prefetch_source<stream_source<char>> source(is, 16);
+        source.ignore(1000);
+        CHECK(source.position() <= 100);
+        CHECK(source.eof());
+        CHECK(source.is_error());
+    }
+}
+
+TEST_CASE("prefetch_source with json_reader")
+{
+    std::string input = make_text(1000);
+    json expected = json::parse(input);
+
+    SECTION("read")
+    {
+        for (std::size_t block_size : {1, 7, 4096, 65536})
+        {
+            std::istringstream is(input);
+            json_decoder<json> decoder;
+            basic_json_reader<char,prefetch_source<stream_source<char>>> reader(prefetch_source<stream_source<char>>(is, block_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("parse error")
+    {
+        std::string s = input;
+        s.insert(s.find("},", 5000) + 1, ",");
+        std::istringstream is(s);
+        json_decoder<json> decoder;
+        basic_json_reader<char,prefetch_source<stream_source<char>>> reader(prefetch_source<stream_source<char>>(is, 64), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::expected_value);
+    }
+    SECTION("early stop")
+    {
+        std::istringstream is(input);
+        basic_json_cursor<char,prefetch_source<stream_source<char>>> cursor(prefetch_source<stream_source<char>>(is, 64));
+        CHECK(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::begin_object);
+    }
+}
+
+TEST_CASE("prefetch_source with binary readers")
+{
+    json expected = json::parse(make_text(500));
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        std::string s(data.begin(), data.end());
+        for (std::size_t block_size : {1, 5, 16384})
+        {
+            std::istringstream is(s);
+            json_decoder<json> decoder;
+            cbor::basic_cbor_reader<prefetch_source<binary_stream_source>> reader(prefetch_source<binary_stream_source>(is, block_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+    SECTION("msgpack")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(expected, data);
+        std::string s(data.begin(), data.end());
+        for (std::size_t block_size : {1, 5, 16384})
+        {
+            std::istringstream is(s);
+            json_decoder<json> decoder;
+            msgpack::basic_msgpack_reader<prefetch_source<binary_stream_source>> reader(prefetch_source<binary_stream_source>(is, block_size), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+}
@@ -0,0 +1,295 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_tape_parser.hpp>
+#include <jsoncons/json_validator.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/counting_allocator.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::error_code read_json(const std::string& input, const json_options& options, std::size_t buffer_length = 16384)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder, options);
+        reader.buffer_length(buffer_length);
+        std::error_code ec;
+        reader.read(ec);
+        return ec;
+    }
+
+    template <class Decoder>
+    std::error_code read_cbor(const std::vector<uint8_t>& input, const cbor::cbor_options& options, Decoder& decoder)
+    {
+        cbor::cbor_bytes_reader reader(input, decoder, options);
+        std::error_code ec;
+        reader.read(ec);
+        return ec;
+    }
+
+    std::error_code read_msgpack(const std::vector<uint8_t>& input, const msgpack::msgpack_options& options)
+    {
+        json_decoder<json> decoder;
+        msgpack::msgpack_bytes_reader reader(input, decoder, options);
+        std::error_code ec;
+        reader.read(ec);
+        return ec;
+    }
+
+} // namespace
+
+TEST_CASE("json max_string_length")
+{
+    json_options options;
+    options.max_string_length(5);
+
+    CHECK_FALSE(read_json(R"(["abcde",{"fghij":1}])", options));
+    CHECK(read_json(R"(["abcdef"])", options) == json_errc::max_string_length_exceeded);
+    CHECK(read_json(R"({"abcdef":1})", options) == json_errc::max_string_length_exceeded);
+    // Escapes count after unescaping
+    CHECK_FALSE(read_json(R"(["a\u0062cde"])", options));
+
+    SECTION("string spanning buffers")
+    {
+        std::string input = "[\"" + std::string(100, 'a') + "\"]";
+        CHECK(read_json(input, options, 8) == json_errc::max_string_length_exceeded);
+        CHECK_FALSE(read_json(input, json_options{}, 8));
+    }
+
+    SECTION("json_tape_parser")
+    {
+        json_tape_parser parser(options);
+        json_decoder<json> decoder;
+        std::error_code ec;
+        parser.parse(std::string(R"(["abcdef"])"), decoder, ec);
+        CHECK(ec == json_errc::max_string_length_exceeded);
+    }
+}
+
+TEST_CASE("json max_input_length")
+{
+    std::string input = R"([1,2,3,4,5,6,7,8,9,10])";
+    json_options options;
+
+    options.max_input_length(input.size());
+    CHECK_FALSE(read_json(input, options));
+
+    options.max_input_length(input.size()-1);
+    CHECK(read_json(input, options) == json_errc::max_input_length_exceeded);
+    CHECK(read_json(input, options, 4) == json_errc::max_input_length_exceeded);
+
+    SECTION("string sources")
+    {
+        std::error_code ec;
+
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder, options);
+        reader.read(ec);
+        CHECK(ec == json_errc::max_input_length_exceeded);
+
+        json_validator validator(input, options);
+        ec = std::error_code();
+        validator.validate(ec);
+        CHECK(ec == json_errc::max_input_length_exceeded);
+
+        ec = std::error_code();
+        json_cursor cursor(input, options, ec);
+        while (!ec && !cursor.done())
+        {
+            cursor.next(ec);
+        }
+        CHECK(ec == json_errc::max_input_length_exceeded);
+
+        CHECK_THROWS_AS(json::parse(input, options), ser_error);
+
+        json_validator within(input, json_options{}.max_input_length(input.size()));
+        ec = std::error_code();
+        within.validate(ec);
+        CHECK_FALSE(ec);
+    }
+
+    json_tape_parser parser(options);
+    json_decoder<json> decoder;
+    std::error_code ec;
+    parser.parse(input, decoder, ec);
+    CHECK(ec == json_errc::max_input_length_exceeded);
+}
+
+TEST_CASE("cbor limits")
+{
+    json j = json::parse(R"({"name":"abcdefgh","values":[1,2,3,4]})");
+    std::vector<uint8_t> input;
+    cbor::encode_cbor(j, input);
+
+    SECTION("max_string_length")
+    {
+        json_decoder<json> decoder;
+        CHECK_FALSE(read_cbor(input, cbor::cbor_options{}.max_string_length(8), decoder));
+        CHECK(decoder.get_result() == j);
+        CHECK(read_cbor(input, cbor::cbor_options{}.max_string_length(7), decoder) == cbor::cbor_errc::max_string_length_exceeded);
+    }
+    SECTION("max_container_length")
+    {
+        json_decoder<json> decoder;
+        CHECK_FALSE(read_cbor(input, cbor::cbor_options{}.max_container_length(4), decoder));
+        CHECK(read_cbor(input, cbor::cbor_options{}.max_container_length(3), decoder) == cbor::cbor_errc::max_container_length_exceeded);
+    }
+    SECTION("max_input_length")
+    {
+        json_decoder<json> decoder;
+        CHECK_FALSE(read_cbor(input, cbor::cbor_options{}.max_input_length(input.size()), decoder));
+        CHECK(read_cbor(input, cbor::cbor_options{}.max_input_length(input.size()-1), decoder) == cbor::cbor_errc::max_input_length_exceeded);
+    }
+    SECTION("max_input_length applies to each value")
+    {
+        std::vector<uint8_t> data(input);
+        data.insert(data.end(), input.begin(), input.end());
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        json_decoder<json> decoder;
+        cbor::cbor_stream_reader reader(is, decoder, cbor::cbor_options{}.max_input_length(input.size()));
+        std::error_code ec;
+        reader.read(ec);
+        CHECK_FALSE(ec);
+        CHECK(decoder.get_result() == j);
+        reader.read(ec);
+        CHECK_FALSE(ec);
+        CHECK(decoder.get_result() == j);
+    }
+    SECTION("huge definite lengths")
+    {
+        json_decoder<json> decoder;
+        // A byte string, text string and array whose headers claim 2^32-1 items
+        std::vector<uint8_t> bytes = {0x5a,0xff,0xff,0xff,0xff,0x01};
+        std::vector<uint8_t> text = {0x7a,0xff,0xff,0xff,0xff,0x61};
+        std::vector<uint8_t> array = {0x9a,0xff,0xff,0xff,0xff,0x01};
+
+        cbor::cbor_options options;
+        options.max_input_length(1000);
+        CHECK(read_cbor(bytes, options, decoder) == cbor::cbor_errc::max_input_length_exceeded);
+        CHECK(read_cbor(text, options, decoder) == cbor::cbor_errc::max_input_length_exceeded);
+        CHECK(read_cbor(array, options, decoder) == cbor::cbor_errc::max_input_length_exceeded);
+
+        options.max_string_length(1000);
+        CHECK(read_cbor(text, options, decoder) == cbor::cbor_errc::max_string_length_exceeded);
+    }
+    SECTION("indefinite length string")
+    {
+        // Chunks "abc" and "defg"
+        std::vector<uint8_t> text = {0x7f,0x63,'a','b','c',0x64,'d','e','f','g',0xff};
+        json_decoder<json> decoder;
+        CHECK_FALSE(read_cbor(text, cbor::cbor_options{}.max_string_length(7), decoder));
+        CHECK(decoder.get_result() == json("abcdefg"));
+        CHECK(read_cbor(text, cbor::cbor_options{}.max_string_length(6), decoder) == cbor::cbor_errc::max_string_length_exceeded);
+    }
+}
+
+TEST_CASE("msgpack limits")
+{
+    json j = json::parse(R"({"name":"abcdefgh","values":[1,2,3,4]})");
+    std::vector<uint8_t> input;
+    msgpack::encode_msgpack(j, input);
+
+    CHECK_FALSE(read_msgpack(input, msgpack::msgpack_options{}.max_string_length(8)));
+    CHECK(read_msgpack(input, msgpack::msgpack_options{}.max_string_length(7)) == msgpack::msgpack_errc::max_string_length_exceeded);
+
+    CHECK_FALSE(read_msgpack(input, msgpack::msgpack_options{}.max_container_length(4)));
+    CHECK(read_msgpack(input, msgpack::msgpack_options{}.max_container_length(3)) == msgpack::msgpack_errc::max_container_length_exceeded);
+
+    CHECK_FALSE(read_msgpack(input, msgpack::msgpack_options{}.max_input_length(input.size())));
+    CHECK(read_msgpack(input, msgpack::msgpack_options{}.max_input_length(input.size()-1)) == msgpack::msgpack_errc::max_input_length_exceeded);
+
+    SECTION("max_input_length applies to each value")
+    {
+        std::vector<uint8_t> data(input);
+        data.insert(data.end(), input.begin(), input.end());
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        json_decoder<json> decoder;
+        msgpack::msgpack_stream_reader reader(is, decoder, msgpack::msgpack_options{}.max_input_length(input.size()));
+        std::error_code ec;
+        reader.read(ec);
+        CHECK_FALSE(ec);
+        CHECK(decoder.get_result() == j);
+        reader.read(ec);
+        CHECK_FALSE(ec);
+        CHECK(decoder.get_result() == j);
+    }
+    SECTION("huge array header")
+    {
+        // array32 claiming 2^31-1 items
+        std::vector<uint8_t> array = {0xdd,0x7f,0xff,0xff,0xff,0x01};
+        CHECK(read_msgpack(array, msgpack::msgpack_options{}.max_input_length(1000)) == msgpack::msgpack_errc::max_input_length_exceeded);
+        CHECK(read_msgpack(array, msgpack::msgpack_options{}.max_container_length(1000)) == msgpack::msgpack_errc::max_container_length_exceeded);
+    }
+}
+
+TEST_CASE("json_decoder allocation budget")
+{
+    using counting_json = basic_json<char,sorted_policy,counting_allocator<char>>;
+
+    std::string input = R"({"first":"A string too long for the short string optimization","second":[1,2,3,4,5,6,7,8,9,10]})";
+
+    SECTION("within budget")
+    {
+        allocation_budget budget;
+        counting_allocator<char> alloc(budget);
+        json_decoder<counting_json> decoder(result_allocator_arg, alloc);
+        json_reader reader(input, decoder);
+        std::error_code ec;
+        reader.read(ec);
+        REQUIRE_FALSE(ec);
+        REQUIRE(decoder.is_valid());
+        counting_json j = decoder.get_result();
+        CHECK(j["first"].as<std::string>() == "A string too long for the short string optimization");
+        CHECK(budget.allocated() > 0);
+        CHECK(budget.peak() >= budget.allocated());
+        CHECK_FALSE(budget.exceeded());
+    }
+    SECTION("budget exceeded")
+    {
+        allocation_budget budget(64);
+        counting_allocator<char> alloc(budget);
+        json_decoder<counting_json> decoder(result_allocator_arg, alloc);
+        json_reader reader(input, decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::max_allocation_exceeded);
+        CHECK_FALSE(decoder.is_valid());
+        CHECK(budget.exceeded());
+    }
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(json::parse(input), data);
+
+        allocation_budget budget(64);
+        counting_allocator<char> alloc(budget);
+        json_decoder<counting_json> decoder(result_allocator_arg, alloc);
+        CHECK(read_cbor(data, cbor::cbor_options{}, decoder) == json_errc::max_allocation_exceeded);
+    }
+    SECTION("released")
+    {
+        allocation_budget budget;
+        {
+            counting_allocator<char> alloc(budget);
+            json_decoder<counting_json> decoder(result_allocator_arg, alloc);
+            json_reader reader(input, decoder);
+            reader.read();
+            counting_json j = decoder.get_result();
+        }
+        CHECK(budget.allocated() == 0);
+    }
+}
@@ -0,0 +1,198 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Splits s into fragments at the offsets i and j
+    template <class Source, class Container>
+    Source make_source(const Container& s, std::size_t i, std::size_t j)
+    {
+        Source source;
+        source.add(s.data(), i);
+        source.add(s.data() + i, j - i);
+        source.add(s.data() + j, s.size() - j);
+        return source;
+    }
+}
+
+TEST_CASE("scatter_source tests")
+{
+    std::string input = "abcdefghij";
+
+    SECTION("get, peek, ignore and read across fragments")
+    {
+        std::vector<std::string> fragments = {"abc", "", "d", "efghi", "j"};
+        scatter_source<char> source(fragments);
+
+        CHECK(source.peek_character().value() == 'a');
+        CHECK(source.get_character().value() == 'a');
+        source.ignore(3);
+        CHECK(source.position() == 5);
+        CHECK(source.get_character().value() == 'e');
+        char buf[10];
+        CHECK(source.read(buf, 4) == 4);
+        CHECK(std::string(buf, 4) == "fghi");
+        CHECK_FALSE(source.eof());
+        CHECK(source.read(buf, 4) == 1);
+        CHECK(buf[0] == 'j');
+        CHECK(source.eof());
+        CHECK_FALSE(source.get_character());
+    }
+    SECTION("read_buffer returns each fragment in place")
+    {
+        scatter_source<char> source = make_source<scatter_source<char>>(input, 3, 7);
+        source.get_character();
+
+        auto s = source.read_buffer();
+        CHECK(s.data() == input.data() + 1);
+        CHECK(s.size() == 2);
+        s = source.read_buffer();
+        CHECK(s.data() == input.data() + 3);
+        CHECK(s.size() == 4);
+        s = source.read_buffer();
+        CHECK(s.size() == 3);
+        CHECK(source.eof());
+        CHECK(source.read_buffer().size() == 0);
+    }
+    SECTION("binary read_view")
+    {
+        std::vector<uint8_t> bytes(input.begin(), input.end());
+        binary_scatter_source source = make_source<binary_scatter_source>(bytes, 3, 7);
+
+        auto s = source.read_view(2);
+        REQUIRE(s.size() == 2);
+        CHECK(std::string(s.data(), s.data()+2) == "ab");
+        s = source.read_view(4);
+        REQUIRE(s.size() == 4);
+        CHECK(std::string(s.data(), s.data()+4) == "cdef");
+        s = source.read_view(8);
+        CHECK(s.size() == 4);
+        CHECK(std::string(s.data(), s.data()+4) == "ghij");
+        CHECK(source.eof());
+    }
+}
+
+TEST_CASE("scatter_source with json_reader")
+{
+    std::string input = R"({"first":"café é","second":[12345,-6.25e-3,true,false,null],"éè":"à𝄞"})";
+    json expected = json::parse(input);
+
+    SECTION("split at every pair of offsets")
+    {
+        for (std::size_t i = 0; i <= input.size(); ++i)
+        {
+            for (std::size_t j = i; j <= input.size(); ++j)
+            {
+                json_decoder<json> decoder;
+                basic_json_reader<char,scatter_source<char>> reader(make_source<scatter_source<char>>(input, i, j), decoder);
+                reader.read();
+                CHECK(decoder.get_result() == expected);
+            }
+        }
+    }
+    SECTION("one character per fragment")
+    {
+        std::vector<std::string> fragments;
+        for (char c : input)
+        {
+            fragments.emplace_back(1, c);
+        }
+        json_decoder<json> decoder;
+        basic_json_reader<char,scatter_source<char>> reader(scatter_source<char>(fragments), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+    SECTION("error in a later fragment")
+    {
+        std::string s = "[1,2,\n3,]";
+        json_decoder<json> decoder;
+        basic_json_reader<char,scatter_source<char>> reader(make_source<scatter_source<char>>(s, 2, 6), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(reader.line() == 2);
+    }
+}
+
+TEST_CASE("scatter_source with json_cursor")
+{
+    std::string input = R"(["one","two",[3,4.5],{"five":"six"}])";
+
+    std::vector<staj_event_type> expected;
+    json_cursor cursor(input);
+    for (; !cursor.done(); cursor.next())
+    {
+        expected.push_back(cursor.current().event_type());
+    }
+
+    for (std::size_t i = 0; i <= input.size(); ++i)
+    {
+        basic_json_cursor<char,scatter_source<char>> c(make_source<scatter_source<char>>(input, i, i));
+        std::vector<staj_event_type> events;
+        for (; !c.done(); c.next())
+        {
+            events.push_back(c.current().event_type());
+        }
+        CHECK(events == expected);
+    }
+}
+
+TEST_CASE("binary_scatter_source with binary readers")
+{
+    json expected = json::parse(R"(
+    {"a":[1,-2,300,-40000,5000000000,-6000000000,1.5,0.1,"seven",null,true,false],"b":{"c":"a longer string value","e":[]}}
+    )");
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        for (std::size_t i = 0; i <= data.size(); ++i)
+        {
+            for (std::size_t j = i; j <= data.size(); j += 3)
+            {
+                json_decoder<json> decoder;
+                cbor::basic_cbor_reader<binary_scatter_source> reader(make_source<binary_scatter_source>(data, i, j), decoder);
+                reader.read();
+                CHECK(decoder.get_result() == expected);
+            }
+        }
+    }
+    SECTION("msgpack")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(expected, data);
+        for (std::size_t i = 0; i <= data.size(); ++i)
+        {
+            for (std::size_t j = i; j <= data.size(); j += 3)
+            {
+                json_decoder<json> decoder;
+                msgpack::basic_msgpack_reader<binary_scatter_source> reader(make_source<binary_scatter_source>(data, i, j), decoder);
+                reader.read();
+                CHECK(decoder.get_result() == expected);
+            }
+        }
+    }
+    SECTION("truncated cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(json(5000000000), data);
+        data.pop_back();
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_scatter_source> reader(make_source<binary_scatter_source>(data, 2, 4), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+}